@@ -0,0 +1,325 @@
+//                                               -*- C++ -*-
+/**
+ *  @brief MemoryMappedSample
+ *
+ *  Copyright 2005-2018 Airbus-EDF-IMACS-Phimeca
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License.
+ *
+ *  This library is distributed in the hope that it will be useful
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+ *
+ */
+#include "otmorris/MemoryMappedSample.hxx"
+#include <openturns/Exception.hxx>
+#include <openturns/Log.hxx>
+#include <openturns/Indices.hxx>
+#include <fstream>
+#include <cstring>
+#include <cstdlib>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace OT;
+
+namespace OTMORRIS
+{
+
+/* Read-only mapping of a whole file, unmapped on destruction */
+class MappedRegion
+{
+public:
+  explicit MappedRegion(const FileName & fileName)
+    : address_(0)
+    , length_(0)
+  {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+      throw FileOpenException(HERE) << "Cannot open file " << fileName;
+    LARGE_INTEGER length;
+    if (!GetFileSizeEx(file, &length))
+    {
+      CloseHandle(file);
+      throw FileOpenException(HERE) << "Cannot get the size of file " << fileName;
+    }
+    length_ = static_cast<UnsignedInteger>(length.QuadPart);
+    if (length_ > 0)
+    {
+      HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+      if (mapping != NULL)
+      {
+        address_ = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+      }
+    }
+    CloseHandle(file);
+#else
+    const int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd < 0)
+      throw FileOpenException(HERE) << "Cannot open file " << fileName;
+    struct stat status;
+    if (fstat(fd, &status) != 0)
+    {
+      close(fd);
+      throw FileOpenException(HERE) << "Cannot get the size of file " << fileName;
+    }
+    length_ = static_cast<UnsignedInteger>(status.st_size);
+    if (length_ > 0)
+    {
+      void * address = mmap(0, length_, PROT_READ, MAP_SHARED, fd, 0);
+      if (address != MAP_FAILED)
+      {
+        address_ = address;
+        // Trajectories are read once, in file order
+        madvise(address_, length_, MADV_SEQUENTIAL);
+      }
+    }
+    close(fd);
+#endif
+    if ((length_ > 0) && (address_ == 0))
+      throw FileOpenException(HERE) << "Cannot map file " << fileName;
+  }
+
+  ~MappedRegion()
+  {
+    if (address_ == 0) return;
+#ifdef _WIN32
+    UnmapViewOfFile(address_);
+#else
+    munmap(address_, length_);
+#endif
+  }
+
+  const char * begin() const
+  {
+    return static_cast<const char *>(address_);
+  }
+
+  UnsignedInteger getLength() const
+  {
+    return length_;
+  }
+
+private:
+  MappedRegion(const MappedRegion &);
+  MappedRegion & operator=(const MappedRegion &);
+
+  void * address_;
+  UnsignedInteger length_;
+};
+
+
+CLASSNAMEINIT(MemoryMappedSample)
+
+/* Default constructor */
+MemoryMappedSample::MemoryMappedSample()
+  : Object()
+  , fileName_()
+  , region_()
+  , size_(0)
+  , dimension_(0)
+  , singlePrecision_(false)
+  , data_(0)
+{
+  // Nothing to do
+}
+
+/* Constructor from a raw row-major file of doubles, or of floats if singlePrecision is true */
+MemoryMappedSample::MemoryMappedSample(const FileName & fileName, const UnsignedInteger dimension, const Bool singlePrecision)
+  : Object()
+  , fileName_(fileName)
+  , region_()
+  , size_(0)
+  , dimension_(dimension)
+  , singlePrecision_(singlePrecision)
+  , data_(0)
+{
+  if (dimension == 0)
+    throw InvalidArgumentException(HERE) << "In MemoryMappedSample::MemoryMappedSample, dimension should be positive";
+  map(0);
+}
+
+/* Constructor from a .npy file */
+MemoryMappedSample::MemoryMappedSample(const FileName & fileName)
+  : Object()
+  , fileName_(fileName)
+  , region_()
+  , size_(0)
+  , dimension_(0)
+  , singlePrecision_(false)
+  , data_(0)
+{
+  map(parseNumpyHeader());
+}
+
+/* Parse the header of a .npy file, returns the offset of the data */
+UnsignedInteger MemoryMappedSample::parseNumpyHeader()
+{
+  std::ifstream file(fileName_.c_str(), std::ios::in | std::ios::binary);
+  if (!file)
+    throw FileOpenException(HERE) << "Cannot open file " << fileName_;
+  // Magic string, major/minor version then little-endian header length
+  unsigned char preamble[12];
+  file.read(reinterpret_cast<char *>(preamble), 10);
+  if (!file || (std::memcmp(preamble, "\x93NUMPY", 6) != 0))
+    throw FileNotFoundException(HERE) << "File " << fileName_ << " is not a .npy file";
+  const UnsignedInteger majorVersion = preamble[6];
+  UnsignedInteger headerLength = preamble[8] + 256 * preamble[9];
+  UnsignedInteger offset = 10;
+  if (majorVersion >= 2)
+  {
+    file.read(reinterpret_cast<char *>(preamble + 10), 2);
+    headerLength += 65536 * (preamble[10] + 256 * preamble[11]);
+    offset = 12;
+  }
+  String header(headerLength, ' ');
+  file.read(&header[0], headerLength);
+  if (!file)
+    throw FileNotFoundException(HERE) << "Truncated .npy header in file " << fileName_;
+
+  // Only little-endian C-ordered doubles or floats can be mapped as is
+  singlePrecision_ = (header.find("'<f4'") != String::npos) || (header.find("'float32'") != String::npos);
+  if (!singlePrecision_ && (header.find("'<f8'") == String::npos) && (header.find("'float64'") == String::npos))
+    throw NotYetImplementedException(HERE) << "In MemoryMappedSample, only little-endian float64 or float32 .npy files are supported, header=" << header;
+  if (header.find("'fortran_order': False") == String::npos)
+    throw NotYetImplementedException(HERE) << "In MemoryMappedSample, only C-ordered .npy files are supported, header=" << header;
+
+  // shape is (size,) or (size, dimension)
+  const String::size_type shapeStart = header.find('(', header.find("'shape'"));
+  const String::size_type shapeEnd = header.find(')', shapeStart);
+  if ((shapeStart == String::npos) || (shapeEnd == String::npos))
+    throw FileNotFoundException(HERE) << "Cannot read the shape in .npy header " << header;
+  Indices shape;
+  const char * cursor = header.c_str() + shapeStart + 1;
+  const char * shapeLast = header.c_str() + shapeEnd;
+  while (cursor < shapeLast)
+  {
+    char * next = 0;
+    const unsigned long value = std::strtoul(cursor, &next, 10);
+    if (next == cursor)
+      ++ cursor;
+    else
+    {
+      shape.add(value);
+      cursor = next;
+    }
+  }
+  if ((shape.getSize() == 0) || (shape.getSize() > 2))
+    throw InvalidDimensionException(HERE) << "In MemoryMappedSample, expected a 1-d or 2-d array, got shape=" << shape;
+  size_ = shape[0];
+  dimension_ = (shape.getSize() == 2 ? shape[1] : 1);
+  return offset + headerLength;
+}
+
+/* Map the file and check its size against the header */
+void MemoryMappedSample::map(const UnsignedInteger offset)
+{
+  region_ = Pointer<MappedRegion>(new MappedRegion(fileName_));
+  const UnsignedInteger length = region_->getLength();
+  if (length < offset)
+    throw FileNotFoundException(HERE) << "File " << fileName_ << " is too short";
+  const UnsignedInteger rowLength = dimension_ * (singlePrecision_ ? sizeof(float) : sizeof(Scalar));
+  if (offset == 0)
+  {
+    // Raw file: the size is deduced from the file length
+    if (length % rowLength != 0)
+      throw InvalidArgumentException(HERE) << "In MemoryMappedSample, file " << fileName_ << " of " << length
+                                           << " bytes does not hold rows of dimension " << dimension_;
+    size_ = length / rowLength;
+  }
+  else if (length - offset < size_ * rowLength)
+    throw FileNotFoundException(HERE) << "File " << fileName_ << " holds less data than announced in its header";
+  data_ = (size_ > 0 ? region_->begin() + offset : 0);
+  LOGINFO(OSS() << "Mapped " << size_ << " rows of dimension " << dimension_ << (singlePrecision_ ? " (float32)" : "") << " from " << fileName_);
+}
+
+/* Size accessor */
+UnsignedInteger MemoryMappedSample::getSize() const
+{
+  return size_;
+}
+
+/* Dimension accessor */
+UnsignedInteger MemoryMappedSample::getDimension() const
+{
+  return dimension_;
+}
+
+/* File name accessor */
+FileName MemoryMappedSample::getFileName() const
+{
+  return fileName_;
+}
+
+/* Whether the file holds floats */
+Bool MemoryMappedSample::isSinglePrecision() const
+{
+  return singlePrecision_;
+}
+
+/* Raw accessors to the row-major mapped data, of doubles or floats */
+const Scalar * MemoryMappedSample::data() const
+{
+  if (singlePrecision_)
+    throw InternalException(HERE) << "In MemoryMappedSample::data, file " << fileName_ << " holds floats";
+  return reinterpret_cast<const Scalar *>(data_);
+}
+
+const float * MemoryMappedSample::singlePrecisionData() const
+{
+  if (!singlePrecision_)
+    throw InternalException(HERE) << "In MemoryMappedSample::singlePrecisionData, file " << fileName_ << " holds doubles";
+  return reinterpret_cast<const float *>(data_);
+}
+
+/* Copy size consecutive rows starting from first into a Sample */
+Sample MemoryMappedSample::getSample(const UnsignedInteger first, const UnsignedInteger size) const
+{
+  if (first + size > size_)
+    throw OutOfBoundException(HERE) << "In MemoryMappedSample::getSample, rows [" << first << ", " << first + size
+                                    << ") exceed the size=" << size_;
+  Sample sample(size, dimension_);
+  if (singlePrecision_)
+  {
+    const float * row = singlePrecisionData() + first * dimension_;
+    for (UnsignedInteger i = 0; i < size; ++i)
+      for (UnsignedInteger j = 0; j < dimension_; ++j, ++row)
+        sample(i, j) = *row;
+    return sample;
+  }
+  const Scalar * row = data() + first * dimension_;
+  for (UnsignedInteger i = 0; i < size; ++i)
+    for (UnsignedInteger j = 0; j < dimension_; ++j, ++row)
+      sample(i, j) = *row;
+  return sample;
+}
+
+/* String converter */
+String MemoryMappedSample::__repr__() const
+{
+  OSS oss;
+  oss << "class=" << MemoryMappedSample::GetClassName()
+      << ", file name=" << fileName_
+      << ", size=" << size_
+      << ", dimension=" << dimension_
+      << ", single precision=" << singlePrecision_;
+  return oss;
+}
+
+} /* namespace OTMORRIS */
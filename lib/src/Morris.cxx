@@ -22,6 +22,25 @@
 #include "otmorris/Morris.hxx"
 #include <openturns/PersistentObjectFactory.hxx>
 #include "otmorris/MorrisExperiment.hxx"
+#include "otmorris/MorrisExperimentGrid.hxx"
+#include "otmorris/MorrisExperimentLHS.hxx"
+#include "otmorris/MorrisExperimentWindingStairs.hxx"
+#include "otmorris/RandomStream.hxx"
+#include <openturns/SquareMatrix.hxx>
+#include <openturns/SymmetricMatrix.hxx>
+#include <openturns/Exception.hxx>
+#include <openturns/Log.hxx>
+#include <openturns/SpecFunc.hxx>
+#include <openturns/TBBImplementation.hxx>
+#include <openturns/EvaluationImplementation.hxx>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <vector>
 
 using namespace OT;
 
@@ -32,9 +51,376 @@ CLASSNAMEINIT(Morris)
 
 static const Factory<Morris> Factory_Morris;
 
+// Binary layout: magic, header, bounds, row-major statistics, output moments then samples as column blocks
+static const char BinaryMagic[8] = {'O', 'T', 'M', 'O', 'R', 'R', 'I', 'S'};
+static const std::uint64_t BinaryVersion = 3;
+enum MorrisBinaryHeader {VERSION = 0, FLAGS, INPUTDIMENSION, OUTPUTDIMENSION, TRAJECTORYNUMBER, SAMPLESIZE, HEADERSIZE};
+static const std::uint64_t BinaryWithSamples = 1;
+static const std::uint64_t BinarySinglePrecision = 2;
+static const std::uint64_t BinaryIngestion = 4;
+static const std::uint64_t BinaryWithDescriptions = 8;
+
+// Trajectories of trajectorySize points starting every stride points, as independent blocks
+static Sample SplitTrajectories(const Sample & sample, const UnsignedInteger N, const UnsignedInteger stride, const UnsignedInteger trajectorySize)
+{
+  Sample blocks(N * trajectorySize, sample.getDimension());
+  for (UnsignedInteger k = 0; k < N; ++k)
+    for (UnsignedInteger i = 0; i < trajectorySize; ++i)
+      blocks[k * trajectorySize + i] = sample[k * stride + i];
+  blocks.setDescription(sample.getDescription());
+  return blocks;
+}
+
+// Experiment of a given class with placeholder parameters, overwritten by load() or loadBinary()
+static Pointer<MorrisExperiment> BuildExperiment(const String & className)
+{
+  if (className == "MorrisExperimentGrid")
+    return Pointer<MorrisExperiment>(new MorrisExperimentGrid(Indices(1, 3), 1));
+  if (className == "MorrisExperimentLHS")
+    return Pointer<MorrisExperiment>(new MorrisExperimentLHS(Sample(1, 1), 1));
+  if (className == "MorrisExperimentWindingStairs")
+    return Pointer<MorrisExperiment>(new MorrisExperimentWindingStairs(Indices(1, 3), 1));
+  throw NotYetImplementedException(HERE) << "In Morris, cannot restore an experiment of class " << className;
+}
+
+// Welford update of the moments of the outputs with one more point
+static inline void AccumulateOutput(const Scalar * y, Point & mean, Point & squaredDeviations, UnsignedInteger & size)
+{
+  ++ size;
+  for (UnsignedInteger j = 0; j < mean.getDimension(); ++j)
+  {
+    const Scalar delta = y[j] - mean[j];
+    mean[j] += delta / size;
+    squaredDeviations[j] += delta * (y[j] - mean[j]);
+  }
+}
+
+// Axes moved by the steps of a trajectory, if each step moves a single, distinct axis
+static Bool DetectTrajectoryAxes(const Scalar * x, const UnsignedInteger inputDimension, UnsignedInteger * axes)
+{
+  // Usual designs are one-at-a-time: each step moves a single, distinct axis
+  // so that the linear system is a scaled permutation and effects are plain ratios
+  Indices moved(inputDimension, 0);
+  for (UnsignedInteger i = 0; i < inputDimension; ++i)
+  {
+    const Scalar * x0 = x + i * inputDimension;
+    const Scalar * x1 = x0 + inputDimension;
+    UnsignedInteger axis = inputDimension;
+    for (UnsignedInteger j = 0; j < inputDimension; ++j)
+    {
+      if (x1[j] == x0[j]) continue;
+      if (axis < inputDimension) return false;
+      axis = j;
+    }
+    if ((axis == inputDimension) || moved[axis]) return false;
+    moved[axis] = 1;
+    axes[i] = axis;
+  }
+  return true;
+}
+
+// Elementary effects of a trajectory whose steps may move several axes
+static void SolveTrajectoryEffects(const Scalar * x, const Scalar * y,
+                                   const Point & diffBounds, const UnsignedInteger outputDimension,
+                                   Scalar * ee)
+{
+  const UnsignedInteger inputDimension = diffBounds.getDimension();
+  // General case: the objective is to evaluate some finite differencies
+  // which requires a system solve
+  SquareMatrix dx(inputDimension);
+  Matrix dy(inputDimension, outputDimension);
+  for (UnsignedInteger i = 0; i < inputDimension; ++i)
+  {
+    // Evaluate dx
+    for (UnsignedInteger j = 0; j < inputDimension; ++j)
+      dx(i, j) = (x[(i + 1) * inputDimension + j] - x[i * inputDimension + j]) / diffBounds[j];
+    // Evaluate dy
+    for (UnsignedInteger j = 0; j < outputDimension; ++j)
+      dy(i, j) = y[(i + 1) * outputDimension + j] - y[i * outputDimension + j];
+  }
+  // Solve linear system
+  const Matrix solution(dx.solveLinearSystem(dy));
+  std::copy(solution.getImplementation()->begin(), solution.getImplementation()->end(), ee);
+}
+
+// Elementary effects of one trajectory, x & y being row-major blocks
+static void TrajectoryEffects(const Scalar * x, const Scalar * y,
+                              const Point & diffBounds, const UnsignedInteger outputDimension,
+                              Scalar * ee)
+{
+  const UnsignedInteger inputDimension = diffBounds.getDimension();
+  Indices axes(inputDimension);
+  if (DetectTrajectoryAxes(x, inputDimension, &axes[0]))
+  {
+    for (UnsignedInteger i = 0; i < inputDimension; ++i)
+    {
+      const UnsignedInteger axis = axes[i];
+      const Scalar dx = (x[(i + 1) * inputDimension + axis] - x[i * inputDimension + axis]) / diffBounds[axis];
+      for (UnsignedInteger j = 0; j < outputDimension; ++j)
+        ee[axis + j * inputDimension] = (y[(i + 1) * outputDimension + j] - y[i * outputDimension + j]) / dx;
+    }
+    return;
+  }
+  SolveTrajectoryEffects(x, y, diffBounds, outputDimension, ee);
+}
+
+// Row-major values as doubles, converted into buffer unless they already are
+static inline const Scalar * AsScalars(const Scalar * data, const UnsignedInteger, std::vector<Scalar> &)
+{
+  return data;
+}
+
+static inline const Scalar * AsScalars(const float * data, const UnsignedInteger size, std::vector<Scalar> & buffer)
+{
+  buffer.assign(data, data + size);
+  return buffer.data();
+}
+
+// Rows of a row-major block, possibly stored as floats
+template <class T>
+struct StoredRows
+{
+  typedef T ValueType;
+  const T * data_;
+  const UnsignedInteger dimension_;
+
+  StoredRows(const T * data, const UnsignedInteger dimension)
+    : data_(data)
+    , dimension_(dimension)
+  {}
+
+  UnsignedInteger getDimension() const
+  {
+    return dimension_;
+  }
+
+  // Rows [first, last), read in place
+  const T * getRows(const UnsignedInteger first, const UnsignedInteger, std::vector<T> &) const
+  {
+    return data_ + first * dimension_;
+  }
+
+}; /* end struct StoredRows */
+
+// Effects of the trajectories starting every stride rows of row-major samples, one row of effects per trajectory
+// Samples and effects may be stored as floats, each trajectory being computed in double
+template <class InputType, class OutputType, class EffectType>
+struct TrajectoryEffectRows
+{
+  typedef EffectType ValueType;
+  const InputType * inputs_;
+  const OutputType * outputs_;
+  const UnsignedInteger stride_;
+  const Point & diffBounds_;
+  const UnsignedInteger outputDimension_;
+
+  TrajectoryEffectRows(const InputType * inputs, const OutputType * outputs, const UnsignedInteger stride,
+                       const Point & diffBounds, const UnsignedInteger outputDimension)
+    : inputs_(inputs)
+    , outputs_(outputs)
+    , stride_(stride)
+    , diffBounds_(diffBounds)
+    , outputDimension_(outputDimension)
+  {}
+
+  UnsignedInteger getDimension() const
+  {
+    return diffBounds_.getDimension() * outputDimension_;
+  }
+
+  // Effects of the trajectories [first, last), computed into buffer
+  const EffectType * getRows(const UnsignedInteger first, const UnsignedInteger last, std::vector<EffectType> & buffer) const
+  {
+    const UnsignedInteger inputDimension = diffBounds_.getDimension();
+    const UnsignedInteger effectDimension = getDimension();
+    buffer.resize((last - first) * effectDimension);
+    std::vector<Scalar> x;
+    std::vector<Scalar> y;
+    std::vector<Scalar> ee(effectDimension);
+    for (UnsignedInteger k = first; k < last; ++k)
+    {
+      TrajectoryEffects(AsScalars(inputs_ + k * stride_ * inputDimension, (inputDimension + 1) * inputDimension, x),
+                        AsScalars(outputs_ + k * stride_ * outputDimension_, (inputDimension + 1) * outputDimension_, y),
+                        diffBounds_, outputDimension_, &ee[0]);
+      std::copy(ee.begin(), ee.end(), buffer.begin() + (k - first) * effectDimension);
+    }
+    return buffer.data();
+  }
+
+}; /* end struct TrajectoryEffectRows */
+
+// Reductions run over fixed blocks of rows whose moments are merged pairwise in a fixed tree order,
+// so that the statistics are bitwise identical whatever the number of threads
+static const UnsignedInteger ReductionBlockSize = 128;
+// Blocks reduced in parallel before being folded, which bounds the memory of their moments
+static const UnsignedInteger ReductionChunkSize = 256;
+
+// Mean, mean of the absolute values and squared deviations to the mean of each block of rows,
+// rows being read or computed one block at a time and accumulated in double
+template <class Rows>
+struct BlockMomentsPolicy
+{
+  const Rows & rows_;
+  const UnsignedInteger size_;
+  const UnsignedInteger firstBlock_;
+  Scalar * moments_;
+
+  BlockMomentsPolicy(const Rows & rows, const UnsignedInteger size, const UnsignedInteger firstBlock, Scalar * moments)
+    : rows_(rows)
+    , size_(size)
+    , firstBlock_(firstBlock)
+    , moments_(moments)
+  {}
+
+  inline void operator()(const TBBImplementation::BlockedRange<UnsignedInteger> & r) const
+  {
+    const UnsignedInteger dimension = rows_.getDimension();
+    std::vector<typename Rows::ValueType> buffer;
+    for (UnsignedInteger block = r.begin(); block != r.end(); ++block)
+    {
+      const UnsignedInteger first = (firstBlock_ + block) * ReductionBlockSize;
+      const UnsignedInteger last = std::min(size_, first + ReductionBlockSize);
+      const typename Rows::ValueType * data = rows_.getRows(first, last, buffer);
+      Scalar * mean = moments_ + 3 * block * dimension;
+      Scalar * absoluteMean = mean + dimension;
+      Scalar * squaredDeviations = absoluteMean + dimension;
+      std::fill(mean, mean + 3 * dimension, 0.0);
+      for (UnsignedInteger n = 0; n < last - first; ++n)
+        for (UnsignedInteger j = 0; j < dimension; ++j)
+        {
+          const Scalar value = data[n * dimension + j];
+          mean[j] += value;
+          absoluteMean[j] += std::abs(value);
+        }
+      for (UnsignedInteger j = 0; j < dimension; ++j)
+      {
+        mean[j] /= (last - first);
+        absoluteMean[j] /= (last - first);
+      }
+      for (UnsignedInteger n = 0; n < last - first; ++n)
+        for (UnsignedInteger j = 0; j < dimension; ++j)
+        {
+          const Scalar deviation = data[n * dimension + j] - mean[j];
+          squaredDeviations[j] += deviation * deviation;
+        }
+    }
+  }
+
+}; /* end struct BlockMomentsPolicy */
+
+// Moments of a run of consecutive blocks, a node of the pairwise reduction tree
+struct RowMoments
+{
+  UnsignedInteger size_;
+  UnsignedInteger level_;
+  Point mean_;
+  Point absoluteMean_;
+  Point squaredDeviations_;
+};
+
+// Chan, Golub & LeVeque merge of the moments of right into the ones of left, the runs of rows being consecutive
+static void MergeRowMoments(RowMoments & left, const RowMoments & right)
+{
+  const Scalar totalSize = left.size_ + right.size_;
+  for (UnsignedInteger j = 0; j < left.mean_.getDimension(); ++j)
+  {
+    const Scalar delta = right.mean_[j] - left.mean_[j];
+    left.mean_[j] += delta * right.size_ / totalSize;
+    left.absoluteMean_[j] += (right.absoluteMean_[j] - left.absoluteMean_[j]) * right.size_ / totalSize;
+    left.squaredDeviations_[j] += right.squaredDeviations_[j] + delta * delta * left.size_ * right.size_ / totalSize;
+  }
+  left.size_ += right.size_;
+  ++ left.level_;
+}
+
+// Mean, mean of the absolute values and sum of squared deviations of size rows,
+// the moments of the blocks of a chunk being computed in parallel then merged pairwise:
+// two runs of 2^l blocks are merged as soon as both are complete, the last incomplete runs
+// being merged from right to left, so that the tree only depends on the number of blocks
+template <class Rows>
+static void ComputeRowMoments(const Rows & rows, const UnsignedInteger size,
+                              Point & mean, Point & absoluteMean, Point & squaredDeviations)
+{
+  const UnsignedInteger dimension = rows.getDimension();
+  const UnsignedInteger blockNumber = (size + ReductionBlockSize - 1) / ReductionBlockSize;
+  mean = Point(dimension);
+  absoluteMean = Point(dimension);
+  squaredDeviations = Point(dimension);
+  if (blockNumber == 0) return;
+  std::vector<Scalar> moments(3 * std::min(blockNumber, ReductionChunkSize) * dimension);
+  // Pending runs, of strictly decreasing levels
+  std::vector<RowMoments> runs;
+  for (UnsignedInteger firstBlock = 0; firstBlock < blockNumber; firstBlock += ReductionChunkSize)
+  {
+    const UnsignedInteger chunkBlockNumber = std::min(ReductionChunkSize, blockNumber - firstBlock);
+    TBBImplementation::ParallelFor(0, chunkBlockNumber, BlockMomentsPolicy<Rows>(rows, size, firstBlock, moments.data()));
+    for (UnsignedInteger block = 0; block < chunkBlockNumber; ++block)
+    {
+      const UnsignedInteger first = (firstBlock + block) * ReductionBlockSize;
+      const Scalar * blockMean = &moments[3 * block * dimension];
+      RowMoments run;
+      run.size_ = std::min(size, first + ReductionBlockSize) - first;
+      run.level_ = 0;
+      run.mean_ = Point(dimension);
+      run.absoluteMean_ = Point(dimension);
+      run.squaredDeviations_ = Point(dimension);
+      std::copy(blockMean, blockMean + dimension, run.mean_.begin());
+      std::copy(blockMean + dimension, blockMean + 2 * dimension, run.absoluteMean_.begin());
+      std::copy(blockMean + 2 * dimension, blockMean + 3 * dimension, run.squaredDeviations_.begin());
+      while (!runs.empty() && (runs.back().level_ == run.level_))
+      {
+        MergeRowMoments(runs.back(), run);
+        run = runs.back();
+        runs.pop_back();
+      }
+      runs.push_back(run);
+    }
+  }
+  RowMoments total(runs.back());
+  for (UnsignedInteger i = runs.size() - 1; i > 0; --i)
+  {
+    RowMoments left(runs[i - 1]);
+    MergeRowMoments(left, total);
+    total = left;
+  }
+  mean = total.mean_;
+  absoluteMean = total.absoluteMean_;
+  squaredDeviations = total.squaredDeviations_;
+}
+
+// Mean, mean of the absolute values and sum of squared deviations of the rows of a row-major block
+template <class T>
+static void ComputeBlockedMoments(const T * data, const UnsignedInteger size, const UnsignedInteger dimension,
+                                  Point & mean, Point & absoluteMean, Point & squaredDeviations)
+{
+  ComputeRowMoments(StoredRows<T>(data, dimension), size, mean, absoluteMean, squaredDeviations);
+}
+
+// Moments of the effects of N trajectories starting every stride rows of row-major samples,
+// the effects being computed one block of trajectories at a time, stored as floats if singlePrecision is true
+template <class InputType, class OutputType>
+static void ComputeEffectMoments(const InputType * inputs, const OutputType * outputs, const UnsignedInteger N, const UnsignedInteger stride,
+                                 const Point & diffBounds, const UnsignedInteger outputDimension, const Bool singlePrecision,
+                                 Point & mean, Point & absoluteMean, Point & squaredDeviations)
+{
+  if (singlePrecision)
+    ComputeRowMoments(TrajectoryEffectRows<InputType, OutputType, float>(inputs, outputs, stride, diffBounds, outputDimension), N, mean, absoluteMean, squaredDeviations);
+  else
+    ComputeRowMoments(TrajectoryEffectRows<InputType, OutputType, Scalar>(inputs, outputs, stride, diffBounds, outputDimension), N, mean, absoluteMean, squaredDeviations);
+}
+
 /** Default constructor */
 Morris::Morris()
   : PersistentObject()
+  , sampleOffset_(0)
+  , missingSamplesReason_()
+  , trajectoryNumber_(0)
+  , outputMean_()
+  , outputSquaredDeviations_()
+  , outputSize_(0)
+  , singlePrecision_(false)
+  , seed_(0)
+  , outputDimension_(0)
 {}
 
 /** Standard constructor */
@@ -42,10 +428,24 @@ Morris::Morris(const Sample & inputSample, const Sample & outputSample,  const I
   : PersistentObject()
   , inputSample_(inputSample)
   , outputSample_(outputSample)
+  , sampleFileName_()
+  , sampleOffset_(0)
+  , missingSamplesReason_()
   , interval_(interval)
   , elementaryEffectsMean_()
   , elementaryEffectsStandardDeviation_()
   , absoluteElementaryEffectsMean_()
+  , elementaryEffectsSquaredDeviations_()
+  , trajectoryNumber_(0)
+  , outputMean_()
+  , outputSquaredDeviations_()
+  , outputSize_(0)
+  , singlePrecision_(false)
+  , experiment_()
+  , seed_(0)
+  , outputDimension_(0)
+  , pending_()
+  , completed_()
 {
   const UnsignedInteger size = inputSample.getSize();
   if (outputSample.getSize() != size)
@@ -59,7 +459,7 @@ Morris::Morris(const Sample & inputSample, const Sample & outputSample,  const I
   if (size != N * (inputDimension + 1))
     throw InvalidArgumentException(HERE) << "In Morris::Morris, sample size should be a multiple of " << inputDimension + 1;
   // Perform evaluation of elementary effects
-  computeEffects(N);
+  computeEffects(inputSample_, outputSample_, inputDimension + 1);
 }
 
 /** Standard constructor with levels definition, number of trajectories, model */
@@ -67,10 +467,24 @@ Morris::Morris(const MorrisExperiment & experiment, const Function & model)
   : PersistentObject()
   , inputSample_()
   , outputSample_()
+  , sampleFileName_()
+  , sampleOffset_(0)
+  , missingSamplesReason_()
   , interval_(experiment.getBounds())
   , elementaryEffectsMean_()
   , elementaryEffectsStandardDeviation_()
   , absoluteElementaryEffectsMean_()
+  , elementaryEffectsSquaredDeviations_()
+  , trajectoryNumber_(0)
+  , outputMean_()
+  , outputSquaredDeviations_()
+  , outputSize_(0)
+  , singlePrecision_(false)
+  , experiment_()
+  , seed_(0)
+  , outputDimension_(0)
+  , pending_()
+  , completed_()
 {
   const UnsignedInteger size = experiment.getSize();
   if (size == 0)
@@ -90,61 +504,654 @@ Morris::Morris(const MorrisExperiment & experiment, const Function & model)
 
   // Compute number of trajectories
   // We could remove one or several trajectories due to replicate
-  const UnsignedInteger N = static_cast<UnsignedInteger>(inputSample_.getSize() / (inputSample_.getDimension() + 1));
+  // Trajectories may share points, as in winding stairs designs
+  const UnsignedInteger stride = experiment.getTrajectoryStride();
+  const UnsignedInteger generatedSize = inputSample_.getSize();
+  const UnsignedInteger N = (generatedSize < inputDimension + 1 ? 0 : (generatedSize - inputDimension - 1) / stride + 1);
+  if ((N == 0) || (size != (N - 1) * stride + inputDimension + 1))
+    throw InvalidArgumentException(HERE) << "In Morris::Morris, sample size=" << generatedSize << " does not match trajectories of "
+                                         << inputDimension + 1 << " points starting every " << stride << " points";
+
+  // Perform evaluation of elementary effects
+  computeEffects(inputSample_, outputSample_, stride);
+}
+
+/* Greedy ordering of the trajectories so that each one starts close to where the previous one ends.
+   A trajectory may be walked backward, its points being stored in design order anyway. */
+static void OrderTrajectories(const Sample & inputSample, const UnsignedInteger N, Indices & order, Indices & backward)
+{
+  const UnsignedInteger dimension = inputSample.getDimension();
+  const UnsignedInteger trajectorySize = dimension + 1;
+  order = Indices(0);
+  backward = Indices(N, 0);
+  std::vector<bool> visited(N, false);
+  UnsignedInteger current = 0;
+  visited[0] = true;
+  order.add(0);
+  for (UnsignedInteger n = 1; n < N; ++n)
+  {
+    const Point exit(inputSample[current * trajectorySize + (backward[current] ? 0 : dimension)]);
+    Scalar bestDistance = SpecFunc::MaxScalar;
+    UnsignedInteger best = 0;
+    UnsignedInteger bestBackward = 0;
+    for (UnsignedInteger k = 0; k < N; ++k)
+    {
+      if (visited[k]) continue;
+      for (UnsignedInteger reversed = 0; reversed < 2; ++reversed)
+      {
+        const UnsignedInteger entry = k * trajectorySize + (reversed ? dimension : 0);
+        Scalar distance = 0.0;
+        for (UnsignedInteger j = 0; j < dimension; ++j)
+        {
+          const Scalar delta = inputSample(entry, j) - exit[j];
+          distance += delta * delta;
+        }
+        if (distance < bestDistance)
+        {
+          bestDistance = distance;
+          best = k;
+          bestBackward = reversed;
+        }
+      }
+    }
+    visited[best] = true;
+    backward[best] = bestBackward;
+    order.add(best);
+    current = best;
+  }
+}
+
+/* Evaluation of the sequence of points of each worker with its own model, as one sample or point by point */
+struct WorkerEvaluationPolicy
+{
+  const Sample & inputSample_;
+  const Morris::FunctionCollection & models_;
+  const Collection<Indices> & sequences_;
+  const Bool pointwise_;
+  std::vector<Scalar> & output_;
+
+  WorkerEvaluationPolicy(const Sample & inputSample, const Morris::FunctionCollection & models, const Collection<Indices> & sequences,
+                         const Bool pointwise, std::vector<Scalar> & output)
+    : inputSample_(inputSample)
+    , models_(models)
+    , sequences_(sequences)
+    , pointwise_(pointwise)
+    , output_(output)
+  {}
+
+  inline void operator()(const TBBImplementation::BlockedRange<UnsignedInteger> & r) const
+  {
+    const UnsignedInteger dimension = inputSample_.getDimension();
+    for (UnsignedInteger worker = r.begin(); worker != r.end(); ++worker)
+    {
+      const Function & model = models_[worker];
+      const UnsignedInteger outputDimension = model.getOutputDimension();
+      const Indices & sequence = sequences_[worker];
+      const UnsignedInteger size = sequence.getSize();
+      if (pointwise_)
+      {
+        // Each point is evaluated right after the previous one of the sequence, which the model may start from
+        for (UnsignedInteger i = 0; i < size; ++i)
+        {
+          const Point y(model(inputSample_[sequence[i]]));
+          std::copy(y.begin(), y.end(), output_.begin() + sequence[i] * outputDimension);
+        }
+        continue;
+      }
+      Sample workerInput(size, dimension);
+      for (UnsignedInteger i = 0; i < size; ++i)
+        for (UnsignedInteger j = 0; j < dimension; ++j)
+          workerInput(i, j) = inputSample_(sequence[i], j);
+      const Sample workerOutput(model(workerInput));
+      for (UnsignedInteger i = 0; i < size; ++i)
+        for (UnsignedInteger j = 0; j < outputDimension; ++j)
+          output_[sequence[i] * outputDimension + j] = workerOutput(i, j);
+    }
+  }
+}; /* end struct WorkerEvaluationPolicy */
+
+/** Constructor evaluating the points in trajectory order on each worker, one sample per worker */
+Morris::Morris(const MorrisExperiment & experiment, const Function & model, const UnsignedInteger workerNumber,
+               const Bool reorder)
+  : PersistentObject()
+  , inputSample_()
+  , outputSample_()
+  , sampleFileName_()
+  , sampleOffset_(0)
+  , missingSamplesReason_()
+  , interval_(experiment.getBounds())
+  , elementaryEffectsMean_()
+  , elementaryEffectsStandardDeviation_()
+  , absoluteElementaryEffectsMean_()
+  , elementaryEffectsSquaredDeviations_()
+  , trajectoryNumber_(0)
+  , outputMean_()
+  , outputSquaredDeviations_()
+  , outputSize_(0)
+  , singlePrecision_(false)
+  , experiment_()
+  , seed_(0)
+  , outputDimension_(0)
+  , pending_()
+  , completed_()
+{
+  if (workerNumber == 0)
+    throw InvalidArgumentException(HERE) << "In Morris::Morris, the number of workers should be positive";
+  // Each worker evaluates its own copy of the model, so that a model implemented in C++ is never called concurrently.
+  // Copies of a Python model share the same Python object, whose calls are serialized by the GIL.
+  FunctionCollection models(workerNumber, model);
+  for (UnsignedInteger worker = 1; worker < workerNumber; ++worker)
+  {
+    const Pointer<EvaluationImplementation> evaluation(model.getEvaluation().getImplementation()->clone());
+    models[worker] = Function(*evaluation);
+  }
+  evaluateWorkers(experiment, models, reorder, false);
+}
+
+/** Constructor evaluating the points in trajectory order one at a time, each worker calling its own model */
+Morris::Morris(const MorrisExperiment & experiment, const FunctionCollection & workerModels, const Bool reorder)
+  : PersistentObject()
+  , inputSample_()
+  , outputSample_()
+  , sampleFileName_()
+  , sampleOffset_(0)
+  , missingSamplesReason_()
+  , interval_(experiment.getBounds())
+  , elementaryEffectsMean_()
+  , elementaryEffectsStandardDeviation_()
+  , absoluteElementaryEffectsMean_()
+  , elementaryEffectsSquaredDeviations_()
+  , trajectoryNumber_(0)
+  , outputMean_()
+  , outputSquaredDeviations_()
+  , outputSize_(0)
+  , singlePrecision_(false)
+  , experiment_()
+  , seed_(0)
+  , outputDimension_(0)
+  , pending_()
+  , completed_()
+{
+  if (workerModels.getSize() == 0)
+    throw InvalidArgumentException(HERE) << "In Morris::Morris, at least one worker model is needed";
+  evaluateWorkers(experiment, workerModels, reorder, true);
+}
+
+/* Evaluate the design of experiment split into one sequence of rows per model, point by point if pointwise */
+void Morris::evaluateWorkers(const MorrisExperiment & experiment, const FunctionCollection & models, const Bool reorder, const Bool pointwise)
+{
+  inputSample_ = experiment.generate();
+  const UnsignedInteger inputDimension = inputSample_.getDimension();
+  const UnsignedInteger size = inputSample_.getSize();
+  const UnsignedInteger outputDimension = models[0].getOutputDimension();
+  for (UnsignedInteger worker = 0; worker < models.getSize(); ++worker)
+  {
+    if (models[worker].getInputDimension() != inputDimension)
+      throw InvalidArgumentException(HERE) << "In Morris::Morris, model should have an input dimension=" << inputDimension
+                                           << ", here model " << worker << " has an input dimension=" << models[worker].getInputDimension();
+    if (models[worker].getOutputDimension() != outputDimension)
+      throw InvalidArgumentException(HERE) << "In Morris::Morris, models should have the same output dimension=" << outputDimension
+                                           << ", here model " << worker << " has an output dimension=" << models[worker].getOutputDimension();
+  }
+  const UnsignedInteger trajectorySize = inputDimension + 1;
+  const UnsignedInteger stride = experiment.getTrajectoryStride();
+  const UnsignedInteger N = (size < trajectorySize ? 0 : (size - trajectorySize) / stride + 1);
+  if ((N == 0) || (size != (N - 1) * stride + trajectorySize))
+    throw InvalidArgumentException(HERE) << "In Morris::Morris, sample size=" << size << " does not match trajectories of "
+                                         << trajectorySize << " points starting every " << stride << " points";
+
+  // Sequence of the rows, split into contiguous parts of similar sizes, one per worker
+  Indices rows(0);
+  if (stride == trajectorySize)
+  {
+    Indices order(N);
+    order.fill();
+    Indices backward(N, 0);
+    if (reorder) OrderTrajectories(inputSample_, N, order, backward);
+    for (UnsignedInteger n = 0; n < N; ++n)
+      for (UnsignedInteger i = 0; i < trajectorySize; ++i)
+        rows.add(order[n] * trajectorySize + (backward[order[n]] ? inputDimension - i : i));
+  }
+  else
+  {
+    // Trajectories sharing points are already chained
+    if (reorder)
+      LOGWARN(OSS() << "In Morris::Morris, trajectories of " << experiment.getClassName() << " are not reordered");
+    rows = Indices(size);
+    rows.fill();
+  }
+  const UnsignedInteger unitNumber = (stride == trajectorySize ? N : size);
+  const UnsignedInteger unitSize = (stride == trajectorySize ? trajectorySize : 1);
+  const UnsignedInteger workerNumber = std::min(models.getSize(), unitNumber);
+  Collection<Indices> sequences(workerNumber);
+  for (UnsignedInteger worker = 0; worker < workerNumber; ++worker)
+  {
+    const UnsignedInteger first = (worker * unitNumber) / workerNumber;
+    const UnsignedInteger last = ((worker + 1) * unitNumber) / workerNumber;
+    sequences[worker] = Indices(rows.begin() + first * unitSize, rows.begin() + last * unitSize);
+  }
+
+  std::vector<Scalar> output(size * outputDimension);
+  const WorkerEvaluationPolicy policy(inputSample_, models, sequences, pointwise, output);
+  TBBImplementation::ParallelFor(0, workerNumber, policy, 1);
+  outputSample_ = Sample(size, outputDimension);
+  for (UnsignedInteger i = 0; i < size; ++i)
+    for (UnsignedInteger j = 0; j < outputDimension; ++j)
+      outputSample_(i, j) = output[i * outputDimension + j];
+
+  computeEffects(inputSample_, outputSample_, stride);
+}
+
+/** Standard constructor with in/out designs mapped from binary files */
+Morris::Morris(const MemoryMappedSample & inputSample, const MemoryMappedSample & outputSample, const Interval & interval)
+  : PersistentObject()
+  , inputSample_()
+  , outputSample_()
+  , sampleFileName_()
+  , sampleOffset_(0)
+  , missingSamplesReason_()
+  , interval_(interval)
+  , elementaryEffectsMean_()
+  , elementaryEffectsStandardDeviation_()
+  , absoluteElementaryEffectsMean_()
+  , elementaryEffectsSquaredDeviations_()
+  , trajectoryNumber_(0)
+  , outputMean_()
+  , outputSquaredDeviations_()
+  , outputSize_(0)
+  , singlePrecision_(false)
+  , experiment_()
+  , seed_(0)
+  , outputDimension_(0)
+  , pending_()
+  , completed_()
+{
+  const UnsignedInteger size = inputSample.getSize();
+  if (outputSample.getSize() != size)
+    throw InvalidArgumentException(HERE) << "In Morris::Morris, input & output samples should be of same size. Here, input sample's size=" << size
+                                         << ", output sample's size=" << outputSample.getSize();
+  if (size == 0)
+    throw InvalidArgumentException(HERE) << "In Morris::Morris, samples should not be empty";
+  const UnsignedInteger inputDimension = inputSample.getDimension();
+  if (interval.getDimension() != inputDimension)
+    throw InvalidArgumentException(HERE) << "In Morris::Morris, interval should have the same dimension as input sample. Here, input sample's dimension=" << inputDimension
+                                         << ", interval's dimension=" << interval.getDimension();
+  const UnsignedInteger N = static_cast<UnsignedInteger>(size / (inputDimension + 1));
   if (size != N * (inputDimension + 1))
     throw InvalidArgumentException(HERE) << "In Morris::Morris, sample size should be a multiple of " << inputDimension + 1;
+  // Trajectories are read in file order directly from the mapped pages, one block of effects at a time
+  const UnsignedInteger outputDimension = outputSample.getDimension();
+  const Point diffBounds(interval_.getUpperBound() - interval_.getLowerBound());
+  const UnsignedInteger stride = inputDimension + 1;
+  Point mean;
+  Point absoluteMean;
+  Point squaredDeviations;
+  if (inputSample.isSinglePrecision() && outputSample.isSinglePrecision())
+    ComputeEffectMoments(inputSample.singlePrecisionData(), outputSample.singlePrecisionData(), N, stride, diffBounds, outputDimension, singlePrecision_, mean, absoluteMean, squaredDeviations);
+  else if (inputSample.isSinglePrecision())
+    ComputeEffectMoments(inputSample.singlePrecisionData(), outputSample.data(), N, stride, diffBounds, outputDimension, singlePrecision_, mean, absoluteMean, squaredDeviations);
+  else if (outputSample.isSinglePrecision())
+    ComputeEffectMoments(inputSample.data(), outputSample.singlePrecisionData(), N, stride, diffBounds, outputDimension, singlePrecision_, mean, absoluteMean, squaredDeviations);
+  else
+    ComputeEffectMoments(inputSample.data(), outputSample.data(), N, stride, diffBounds, outputDimension, singlePrecision_, mean, absoluteMean, squaredDeviations);
+  mergeEffectMoments(N, outputDimension, mean, absoluteMean, squaredDeviations);
+  if (outputSample.isSinglePrecision())
+    ComputeBlockedMoments(outputSample.singlePrecisionData(), size, outputDimension, mean, absoluteMean, squaredDeviations);
+  else
+    ComputeBlockedMoments(outputSample.data(), size, outputDimension, mean, absoluteMean, squaredDeviations);
+  mergeOutputs(mean, squaredDeviations, size);
+  missingSamplesReason_ = "the statistics were computed from memory-mapped files";
+}
 
-  // Perform evaluation of elementary effects
-  computeEffects(N);
+// Method that computes the effects of the trajectories starting every stride points of the samples and merges them
+void Morris::computeEffects(const Sample & inputSample, const Sample & outputSample, const UnsignedInteger stride, const UnsignedInteger sharedSize)
+{
+  const UnsignedInteger inputDimension(inputSample.getDimension());
+  const UnsignedInteger outputDimension(outputSample.getDimension());
+  const UnsignedInteger size(inputSample.getSize());
+  const UnsignedInteger N(size < inputDimension + 1 ? 0 : (size - inputDimension - 1) / stride + 1);
+  if (N == 0) return;
+  const Point diffBounds(interval_.getUpperBound() - interval_.getLowerBound());
+  // Trajectories are contiguous row-major blocks of the samples, computed in parallel
+  Point mean;
+  Point absoluteMean;
+  Point squaredDeviations;
+  ComputeEffectMoments(&inputSample(0, 0), &outputSample(0, 0), N, stride, diffBounds, outputDimension, singlePrecision_, mean, absoluteMean, squaredDeviations);
+  mergeEffectMoments(N, outputDimension, mean, absoluteMean, squaredDeviations);
+  // Moments of the outputs, each point shared by consecutive trajectories being counted once
+  const UnsignedInteger outputSize = (N - 1) * stride + inputDimension + 1 - sharedSize;
+  ComputeBlockedMoments(&outputSample(sharedSize, 0), outputSize, outputDimension, mean, absoluteMean, squaredDeviations);
+  mergeOutputs(mean, squaredDeviations, outputSize);
 }
 
+// Elementary effects of one trajectory, x & y being row-major blocks
+// ee is stored column-major, ie ee[i + j * inputDimension] is the effect of input i on output j
+void Morris::ComputeTrajectoryEffects(const Scalar * x, const Scalar * y,
+                                      const Point & diffBounds, const UnsignedInteger outputDimension,
+                                      Scalar * ee)
+{
+  TrajectoryEffects(x, y, diffBounds, outputDimension, ee);
+}
 
-// Method that allocate and compute effects
-void Morris::computeEffects(const UnsignedInteger N)
+// Method that merges new elementary effects into mean/std
+void Morris::mergeEffects(const Sample & elementaryEffects)
 {
-  // Allocate samples
-  const UnsignedInteger inputDimension(inputSample_.getDimension());
-  const UnsignedInteger outputDimension(outputSample_.getDimension());
-  const Point diff_bounds(interval_.getUpperBound() - interval_.getLowerBound());
-  Sample elementaryEffects(N, inputDimension * outputDimension);
-  Sample absoluteElementaryEffects(N, inputDimension * outputDimension);
-  SquareMatrix dx(inputDimension, inputDimension);
-  Matrix dy(inputDimension, outputDimension);
-  Matrix ee;
-  // Perform evaluation of elementary effects
-  // Requires k system solves
-  UnsignedInteger blockIndex(0);
-  for (UnsignedInteger k = 0; k < N; ++k)
+  const UnsignedInteger size = elementaryEffects.getSize();
+  if (size == 0) return;
+  const UnsignedInteger dimension(elementaryEffects.getDimension());
+  // Mean/squared deviations of the new effects, independent of the number of threads
+  Point mean;
+  Point absoluteMean;
+  Point squaredDeviations;
+  ComputeBlockedMoments(&elementaryEffects(0, 0), size, dimension, mean, absoluteMean, squaredDeviations);
+  mergeEffectMoments(size, dimension / interval_.getDimension(), mean, absoluteMean, squaredDeviations);
+}
+
+// Method that merges the moments of size new elementary effects into mean/std
+void Morris::mergeEffectMoments(const UnsignedInteger size, const UnsignedInteger outputDimension,
+                                Point & mean, Point & absoluteMean, Point & squaredDeviations)
+{
+  if (size == 0) return;
+  const UnsignedInteger inputDimension(interval_.getDimension());
+  const UnsignedInteger dimension(inputDimension * outputDimension);
+  if (trajectoryNumber_ == 0)
   {
-    // Indices of current trajectory are k * (inputDimension+1) to (k+1)* (inputDimension+1)
-    // The objective is to evaluate some finite differencies
-    for (UnsignedInteger i = 0; i < inputDimension; ++i)
+    // Allocate ee mean/std support
+    elementaryEffectsMean_ = Sample(outputDimension, inputDimension);
+    absoluteElementaryEffectsMean_ = Sample(outputDimension, inputDimension);
+    elementaryEffectsStandardDeviation_ = Sample(outputDimension, inputDimension);
+    elementaryEffectsSquaredDeviations_ = Sample(outputDimension, inputDimension);
+  }
+  else if (elementaryEffectsMean_.getSize() != outputDimension)
+    throw InvalidArgumentException(HERE) << "In Morris, expected effects on " << elementaryEffectsMean_.getSize()
+                                         << " outputs, got effects on " << outputDimension << " outputs";
+  // Merge with the current statistics (Chan, Golub & LeVeque update)
+  // Effect j is the one of input j % inputDimension on output j / inputDimension
+  const Scalar previousSize = trajectoryNumber_;
+  const Scalar totalSize = previousSize + size;
+  for (UnsignedInteger j = 0; j < dimension; ++j)
+  {
+    const UnsignedInteger marginal = j / inputDimension;
+    const UnsignedInteger i = j % inputDimension;
+    if (trajectoryNumber_ > 0)
     {
-      // Evaluate dx
-      for (UnsignedInteger j = 0; j < inputDimension; ++j)
-        dx(i, j) = (inputSample_(blockIndex + i + 1, j) - inputSample_(blockIndex + i, j)) / diff_bounds[j];
-      // Evaluate dy
-      for (UnsignedInteger j = 0; j < outputDimension; ++j)
-        dy(i, j) = outputSample_(blockIndex + i + 1, j) - outputSample_(blockIndex + i, j);
-    }
-    // Solve linear system
-    ee = dx.solveLinearSystem(dy);
-    // Stores the elementary effects
-    elementaryEffects[k] = Point(*ee.getImplementation());
-    absoluteElementaryEffects[k] = Point(*ee.getImplementation());
-    for (UnsignedInteger j = 0; j < inputDimension * outputDimension; ++j)
-      absoluteElementaryEffects[k][j] = std::abs(absoluteElementaryEffects[k][j]);
-    blockIndex += inputDimension + 1;
-  } // end for k
-  // Allocate ee mean/std support
-  elementaryEffectsMean_ = Sample(outputDimension, inputDimension);
-  absoluteElementaryEffectsMean_ = Sample(outputDimension, inputDimension);
-  elementaryEffectsStandardDeviation_ = Sample(outputDimension, inputDimension);
-  // Evaluate mean/std
-  // elementary effects compute mean
-  elementaryEffectsMean_.getImplementation()->setData(elementaryEffects.computeMean());
-  absoluteElementaryEffectsMean_.getImplementation()->setData(absoluteElementaryEffects.computeMean());
-  elementaryEffectsStandardDeviation_.getImplementation()->setData(elementaryEffects.computeStandardDeviationPerComponent());
+      const Scalar delta = mean[j] - elementaryEffectsMean_(marginal, i);
+      mean[j] = elementaryEffectsMean_(marginal, i) + delta * size / totalSize;
+      absoluteMean[j] = absoluteElementaryEffectsMean_(marginal, i) + (absoluteMean[j] - absoluteElementaryEffectsMean_(marginal, i)) * size / totalSize;
+      squaredDeviations[j] += elementaryEffectsSquaredDeviations_(marginal, i) + delta * delta * previousSize * size / totalSize;
+    }
+    elementaryEffectsMean_(marginal, i) = mean[j];
+    absoluteElementaryEffectsMean_(marginal, i) = absoluteMean[j];
+    elementaryEffectsSquaredDeviations_(marginal, i) = squaredDeviations[j];
+    elementaryEffectsStandardDeviation_(marginal, i) = (totalSize > 1.0 ? std::sqrt(squaredDeviations[j] / (totalSize - 1.0)) : 0.0);
+  }
+  trajectoryNumber_ += size;
+}
+
+// Method that merges the moments of new outputs
+void Morris::mergeOutputs(const Point & mean, const Point & squaredDeviations, const UnsignedInteger size)
+{
+  if (size == 0) return;
+  if (outputSize_ == 0)
+  {
+    outputMean_ = mean;
+    outputSquaredDeviations_ = squaredDeviations;
+    outputSize_ = size;
+    return;
+  }
+  // Same update as the effects
+  const Scalar previousSize = outputSize_;
+  const Scalar totalSize = previousSize + size;
+  for (UnsignedInteger j = 0; j < outputMean_.getDimension(); ++j)
+  {
+    const Scalar delta = mean[j] - outputMean_[j];
+    outputMean_[j] += delta * size / totalSize;
+    outputSquaredDeviations_[j] += squaredDeviations[j] + delta * delta * previousSize * size / totalSize;
+  }
+  outputSize_ += size;
+}
+
+/* Add trajectories, updating the statistics from the new trajectories only */
+void Morris::add(const Sample & inputSample, const Sample & outputSample)
+{
+  const UnsignedInteger size = inputSample.getSize();
+  if (outputSample.getSize() != size)
+    throw InvalidArgumentException(HERE) << "In Morris::add, input & output samples should be of same size. Here, input sample's size=" << size
+                                         << ", output sample's size=" << outputSample.getSize();
+  const UnsignedInteger inputDimension = interval_.getDimension();
+  if (inputSample.getDimension() != inputDimension)
+    throw InvalidArgumentException(HERE) << "In Morris::add, input sample should be of dimension " << inputDimension
+                                         << ", here dimension=" << inputSample.getDimension();
+  if ((trajectoryNumber_ > 0) && (outputSample.getDimension() != elementaryEffectsMean_.getSize()))
+    throw InvalidArgumentException(HERE) << "In Morris::add, output sample should be of dimension " << elementaryEffectsMean_.getSize()
+                                         << ", here dimension=" << outputSample.getDimension();
+  if (size % (inputDimension + 1) != 0)
+    throw InvalidArgumentException(HERE) << "In Morris::add, sample size should be a multiple of " << inputDimension + 1;
+  if (size == 0) return;
+  appendSamples(inputSample, outputSample, inputDimension + 1);
+  computeEffects(inputSample, outputSample, inputDimension + 1);
+}
+
+// Append the trajectories starting every stride points to the samples, as independent blocks
+void Morris::appendSamples(const Sample & inputSample, const Sample & outputSample, const UnsignedInteger stride)
+{
+  loadSamples();
+  if (!missingSamplesReason_.empty()) return;
+  const UnsignedInteger trajectorySize = interval_.getDimension() + 1;
+  // A stored chain of trajectories sharing points is split first
+  if (inputSample_.getSize() != trajectoryNumber_ * trajectorySize)
+  {
+    const UnsignedInteger storedStride = computeSampleStride();
+    inputSample_ = SplitTrajectories(inputSample_, trajectoryNumber_, storedStride, trajectorySize);
+    outputSample_ = SplitTrajectories(outputSample_, trajectoryNumber_, storedStride, trajectorySize);
+  }
+  Sample input(inputSample);
+  Sample output(outputSample);
+  if (stride != trajectorySize)
+  {
+    const UnsignedInteger N = (inputSample.getSize() - trajectorySize) / stride + 1;
+    input = SplitTrajectories(inputSample, N, stride, trajectorySize);
+    output = SplitTrajectories(outputSample, N, stride, trajectorySize);
+  }
+  if (inputSample_.getSize() == 0)
+  {
+    inputSample_ = input;
+    outputSample_ = output;
+  }
+  else
+  {
+    inputSample_.add(input);
+    outputSample_.add(output);
+  }
+}
+
+/* Add extraN trajectories drawn from experiment and evaluated by model */
+void Morris::extend(const MorrisExperiment & experiment, const Function & model, const UnsignedInteger extraN)
+{
+  if (!(experiment.getBounds() == interval_))
+    throw InvalidArgumentException(HERE) << "In Morris::extend, experiment should be defined on the bounds=" << interval_
+                                         << ", here bounds=" << experiment.getBounds();
+  if (extraN == 0) return;
+  Pointer<MorrisExperiment> extraExperiment(experiment.clone());
+  extraExperiment->setTrajectoryNumber(extraN);
+  const Sample inputSample(extraExperiment->generate());
+  const UnsignedInteger stride = extraExperiment->getTrajectoryStride();
+  if (stride == interval_.getDimension() + 1)
+  {
+    add(inputSample, model(inputSample));
+    return;
+  }
+  // Trajectories sharing points are stored as independent blocks, their shared points being evaluated once
+  if ((trajectoryNumber_ > 0) && (model.getOutputDimension() != elementaryEffectsMean_.getSize()))
+    throw InvalidArgumentException(HERE) << "In Morris::extend, model should be of output dimension " << elementaryEffectsMean_.getSize()
+                                         << ", here dimension=" << model.getOutputDimension();
+  const Sample outputSample(model(inputSample));
+  appendSamples(inputSample, outputSample, stride);
+  computeEffects(inputSample, outputSample, stride);
+}
+
+/** Constructor for results added in any order, inputs being regenerated from experiment.generate(k, N, seed) */
+Morris::Morris(const MorrisExperiment & experiment, const UnsignedInteger seed, const UnsignedInteger outputDimension)
+  : PersistentObject()
+  , inputSample_()
+  , outputSample_()
+  , sampleFileName_()
+  , sampleOffset_(0)
+  , missingSamplesReason_("the results are added one point at a time")
+  , interval_(experiment.getBounds())
+  , elementaryEffectsMean_()
+  , elementaryEffectsStandardDeviation_()
+  , absoluteElementaryEffectsMean_()
+  , elementaryEffectsSquaredDeviations_()
+  , trajectoryNumber_(0)
+  , outputMean_()
+  , outputSquaredDeviations_()
+  , outputSize_(0)
+  , singlePrecision_(false)
+  , experiment_(experiment.clone())
+  , seed_(seed)
+  , outputDimension_(outputDimension)
+  , pending_()
+  , completed_(experiment.getTrajectoryNumber(), false)
+{
+  if (outputDimension == 0)
+    throw InvalidArgumentException(HERE) << "In Morris::Morris, output dimension should be positive";
+}
+
+/** Constructor for results added in any order together with their inputs */
+Morris::Morris(const Interval & interval, const UnsignedInteger outputDimension)
+  : PersistentObject()
+  , inputSample_()
+  , outputSample_()
+  , sampleFileName_()
+  , sampleOffset_(0)
+  , missingSamplesReason_("the results are added one point at a time")
+  , interval_(interval)
+  , elementaryEffectsMean_()
+  , elementaryEffectsStandardDeviation_()
+  , absoluteElementaryEffectsMean_()
+  , elementaryEffectsSquaredDeviations_()
+  , trajectoryNumber_(0)
+  , outputMean_()
+  , outputSquaredDeviations_()
+  , outputSize_(0)
+  , singlePrecision_(false)
+  , experiment_()
+  , seed_(0)
+  , outputDimension_(outputDimension)
+  , pending_()
+  , completed_()
+{
+  if (outputDimension == 0)
+    throw InvalidArgumentException(HERE) << "In Morris::Morris, output dimension should be positive";
+}
+
+/* Add the output of one point of a reproducible design trajectory */
+Bool Morris::addResult(const UnsignedInteger trajectoryIndex, const UnsignedInteger stepIndex, const Point & output)
+{
+  if (experiment_.isNull())
+    throw InvalidArgumentException(HERE) << "In Morris::addResult, inputs are needed unless Morris is built from a reproducible experiment";
+  if (trajectoryIndex >= completed_.size())
+    throw InvalidArgumentException(HERE) << "In Morris::addResult, trajectory index=" << trajectoryIndex << " exceeds the number of trajectories=" << completed_.size();
+  return addResult(trajectoryIndex, stepIndex, Point(), output);
+}
+
+/* Add the output of one point of a trajectory together with its input */
+Bool Morris::addResult(const UnsignedInteger trajectoryIndex, const UnsignedInteger stepIndex, const Point & input, const Point & output)
+{
+  const UnsignedInteger inputDimension = interval_.getDimension();
+  if (stepIndex > inputDimension)
+    throw InvalidArgumentException(HERE) << "In Morris::addResult, step index=" << stepIndex << " should not exceed the input dimension=" << inputDimension;
+  if (output.getDimension() != outputDimension_)
+    throw InvalidArgumentException(HERE) << "In Morris::addResult, output should be of dimension " << outputDimension_ << ", here dimension=" << output.getDimension();
+  if (experiment_.isNull() && (input.getDimension() != inputDimension))
+    throw InvalidArgumentException(HERE) << "In Morris::addResult, input should be of dimension " << inputDimension << ", here dimension=" << input.getDimension();
+  if (trajectoryIndex >= completed_.size())
+    completed_.resize(trajectoryIndex + 1, false);
+  // Late replicates of already folded trajectories are discarded
+  if (completed_[trajectoryIndex])
+  {
+    LOGWARN(OSS() << "In Morris::addResult, trajectory " << trajectoryIndex << " is already complete, result discarded");
+    return false;
+  }
+  PendingTrajectoryMap::iterator it = pending_.find(trajectoryIndex);
+  if (it == pending_.end())
+  {
+    PendingTrajectory trajectory;
+    if (experiment_.isNull())
+      trajectory.input_ = Sample(inputDimension + 1, inputDimension);
+    trajectory.output_ = Sample(inputDimension + 1, outputDimension_);
+    trajectory.received_ = Indices(inputDimension + 1, 0);
+    trajectory.receivedNumber_ = 0;
+    it = pending_.insert(PendingTrajectoryMap::value_type(trajectoryIndex, trajectory)).first;
+  }
+  PendingTrajectory & trajectory = it->second;
+  if (trajectory.received_[stepIndex])
+  {
+    LOGWARN(OSS() << "In Morris::addResult, step " << stepIndex << " of trajectory " << trajectoryIndex << " already received, result discarded");
+    return false;
+  }
+  trajectory.received_[stepIndex] = 1;
+  ++ trajectory.receivedNumber_;
+  trajectory.output_[stepIndex] = output;
+  if (experiment_.isNull())
+    trajectory.input_[stepIndex] = input;
+  if (trajectory.receivedNumber_ <= inputDimension)
+    return false;
+  foldTrajectory(trajectoryIndex, trajectory);
+  pending_.erase(it);
+  return true;
+}
+
+/* Fold a complete trajectory into the statistics */
+void Morris::foldTrajectory(const UnsignedInteger trajectoryIndex, PendingTrajectory & trajectory)
+{
+  const UnsignedInteger inputDimension = interval_.getDimension();
+  // Inputs of reproducible designs are regenerated, trajectory by trajectory
+  if (!experiment_.isNull())
+    trajectory.input_ = experiment_->generate(trajectoryIndex, completed_.size(), seed_);
+  Point x((inputDimension + 1) * inputDimension);
+  Point y((inputDimension + 1) * outputDimension_);
+  for (UnsignedInteger i = 0; i <= inputDimension; ++i)
+  {
+    for (UnsignedInteger j = 0; j < inputDimension; ++j)
+      x[i * inputDimension + j] = trajectory.input_(i, j);
+    for (UnsignedInteger j = 0; j < outputDimension_; ++j)
+      y[i * outputDimension_ + j] = trajectory.output_(i, j);
+  }
+  Sample elementaryEffects(1, inputDimension * outputDimension_);
+  ComputeTrajectoryEffects(&x[0], &y[0], interval_.getUpperBound() - interval_.getLowerBound(), outputDimension_, &elementaryEffects(0, 0));
+  mergeEffects(elementaryEffects);
+  Point outputMean(outputDimension_);
+  Point outputSquaredDeviations(outputDimension_);
+  UnsignedInteger outputSize = 0;
+  for (UnsignedInteger i = 0; i <= inputDimension; ++i)
+    AccumulateOutput(&y[i * outputDimension_], outputMean, outputSquaredDeviations, outputSize);
+  mergeOutputs(outputMean, outputSquaredDeviations, outputSize);
+  completed_[trajectoryIndex] = true;
+}
+
+/* Number of trajectories the effects are computed from */
+UnsignedInteger Morris::getTrajectoryNumber() const
+{
+  return trajectoryNumber_;
+}
+
+/* Number of trajectories waiting for some results */
+UnsignedInteger Morris::getPendingTrajectoryNumber() const
+{
+  return pending_.size();
+}
+
+/* Whether the effects of new trajectories are stored as floats, the statistics being accumulated in double */
+void Morris::setSinglePrecision(const Bool singlePrecision)
+{
+  singlePrecision_ = singlePrecision;
+}
+
+Bool Morris::getSinglePrecision() const
+{
+  return singlePrecision_;
 }
 
 /* Virtual constructor method */
@@ -174,9 +1181,659 @@ Point Morris::getStandardDeviationElementaryEffects(const UnsignedInteger margin
   return elementaryEffectsStandardDeviation_[marginal];
 }
 
+/* Check that the samples hold the trajectories of the statistics */
+void Morris::checkSamples() const
+{
+  loadSamples();
+  if (!missingSamplesReason_.empty())
+    throw InvalidArgumentException(HERE) << "In Morris, the trajectories are not available: " << missingSamplesReason_;
+}
+
+/* Stride of the trajectories of the samples, checked against the statistics */
+UnsignedInteger Morris::computeSampleStride() const
+{
+  checkSamples();
+  const UnsignedInteger inputDimension = interval_.getDimension();
+  const UnsignedInteger size = inputSample_.getSize();
+  // Samples hold either independent trajectories or a chain of trajectories sharing one point
+  UnsignedInteger stride = inputDimension + 1;
+  if ((size != trajectoryNumber_ * stride) && (trajectoryNumber_ > 0) && (size == trajectoryNumber_ * inputDimension + 1))
+    stride = inputDimension;
+  if ((trajectoryNumber_ == 0) || (size != (trajectoryNumber_ - 1) * stride + inputDimension + 1))
+    throw InternalException(HERE) << "In Morris, the samples do not hold the " << trajectoryNumber_ << " trajectories of the statistics";
+  return stride;
+}
+
+/* Effects of all the trajectories of the samples */
+Sample Morris::computeSampleEffects() const
+{
+  const UnsignedInteger stride = computeSampleStride();
+  const UnsignedInteger inputDimension = interval_.getDimension();
+  const UnsignedInteger outputDimension = outputSample_.getDimension();
+  const Point diffBounds(interval_.getUpperBound() - interval_.getLowerBound());
+  Sample elementaryEffects(trajectoryNumber_, inputDimension * outputDimension);
+  Point x((inputDimension + 1) * inputDimension);
+  Point y((inputDimension + 1) * outputDimension);
+  Point ee(inputDimension * outputDimension);
+  for (UnsignedInteger k = 0; k < trajectoryNumber_; ++k)
+  {
+    for (UnsignedInteger i = 0; i <= inputDimension; ++i)
+    {
+      for (UnsignedInteger j = 0; j < inputDimension; ++j)
+        x[i * inputDimension + j] = inputSample_(k * stride + i, j);
+      for (UnsignedInteger j = 0; j < outputDimension; ++j)
+        y[i * outputDimension + j] = outputSample_(k * stride + i, j);
+    }
+    ComputeTrajectoryEffects(&x[0], &y[0], diffBounds, outputDimension, &ee[0]);
+    elementaryEffects[k] = ee;
+  }
+  return elementaryEffects;
+}
+
+/* Elementary effects of each trajectory, recomputed from the samples */
+Sample Morris::getElementaryEffects(const UnsignedInteger marginal) const
+{
+  if (marginal >= elementaryEffectsMean_.getSize()) throw InvalidArgumentException(HERE) << "Cannot exceed dimension";
+  const UnsignedInteger inputDimension = interval_.getDimension();
+  Indices indices(inputDimension);
+  indices.fill(marginal * inputDimension);
+  return computeSampleEffects().getMarginal(indices);
+}
+
+/* Standard error of the mean of the effects, or of their absolute values, over groups of trajectories */
+Point Morris::computeStandardError(const UnsignedInteger marginal, const UnsignedInteger groupSize, const Bool absolute) const
+{
+  if (marginal >= elementaryEffectsMean_.getSize()) throw InvalidArgumentException(HERE) << "Cannot exceed dimension";
+  if ((groupSize == 0) || (trajectoryNumber_ % groupSize != 0))
+    throw InvalidArgumentException(HERE) << "In Morris, the group size=" << groupSize << " should divide the number of trajectories=" << trajectoryNumber_;
+  const UnsignedInteger inputDimension = interval_.getDimension();
+  const UnsignedInteger groupNumber = trajectoryNumber_ / groupSize;
+  if (groupNumber < 2)
+    throw InvalidArgumentException(HERE) << "In Morris, at least two groups of trajectories are needed, here " << groupNumber;
+  // Plain trajectories only need the statistics
+  if ((groupSize == 1) && !absolute)
+  {
+    Point standardError(elementaryEffectsStandardDeviation_[marginal]);
+    standardError /= std::sqrt(1.0 * trajectoryNumber_);
+    return standardError;
+  }
+  const Sample elementaryEffects(getElementaryEffects(marginal));
+  // Groups, eg antithetic pairs, are dependent: their means are the independent draws
+  Sample groupMeans(groupNumber, inputDimension);
+  for (UnsignedInteger k = 0; k < trajectoryNumber_; ++k)
+    for (UnsignedInteger i = 0; i < inputDimension; ++i)
+    {
+      const Scalar effect = elementaryEffects(k, i);
+      groupMeans(k / groupSize, i) += (absolute ? std::abs(effect) : effect) / groupSize;
+    }
+  const Point mean(groupMeans.computeMean());
+  Point standardError(inputDimension);
+  for (UnsignedInteger i = 0; i < inputDimension; ++i)
+  {
+    Scalar squaredDeviations = 0.0;
+    for (UnsignedInteger g = 0; g < groupNumber; ++g)
+      squaredDeviations += (groupMeans(g, i) - mean[i]) * (groupMeans(g, i) - mean[i]);
+    standardError[i] = std::sqrt(squaredDeviations / (groupNumber - 1.0) / groupNumber);
+  }
+  return standardError;
+}
+
+/* Standard errors of the means */
+Point Morris::getMeanElementaryEffectsStandardError(const UnsignedInteger marginal, const UnsignedInteger groupSize) const
+{
+  return computeStandardError(marginal, groupSize, false);
+}
+
+Point Morris::getMeanAbsoluteElementaryEffectsStandardError(const UnsignedInteger marginal, const UnsignedInteger groupSize) const
+{
+  return computeStandardError(marginal, groupSize, true);
+}
+
+// Statistics of the effects recomputed under random permutations, one row per permutation
+struct PermutationTestPolicy
+{
+  const Scalar * effects_;
+  const Scalar * inputs_;
+  const Scalar * outputs_;
+  const UnsignedInteger * axes_;
+  const Scalar * inverseSteps_;
+  const char * oneAtATime_;
+  const Point & diffBounds_;
+  const UnsignedInteger trajectoryNumber_;
+  const UnsignedInteger outputDimension_;
+  const Bool shuffleOutputs_;
+  const UnsignedInteger seed_;
+  Scalar * statistics_;
+
+  PermutationTestPolicy(const Scalar * effects, const Scalar * inputs, const Scalar * outputs,
+                        const UnsignedInteger * axes, const Scalar * inverseSteps, const char * oneAtATime,
+                        const Point & diffBounds, const UnsignedInteger trajectoryNumber, const UnsignedInteger outputDimension,
+                        const Bool shuffleOutputs, const UnsignedInteger seed, Scalar * statistics)
+    : effects_(effects)
+    , inputs_(inputs)
+    , outputs_(outputs)
+    , axes_(axes)
+    , inverseSteps_(inverseSteps)
+    , oneAtATime_(oneAtATime)
+    , diffBounds_(diffBounds)
+    , trajectoryNumber_(trajectoryNumber)
+    , outputDimension_(outputDimension)
+    , shuffleOutputs_(shuffleOutputs)
+    , seed_(seed)
+    , statistics_(statistics)
+  {}
+
+  inline void operator()(const TBBImplementation::BlockedRange<UnsignedInteger> & r) const
+  {
+    const UnsignedInteger inputDimension = diffBounds_.getDimension();
+    const UnsignedInteger dimension = inputDimension * outputDimension_;
+    // Accumulators are input-major so that the inner loop runs over contiguous outputs
+    std::vector<Scalar> sum(dimension);
+    std::vector<UnsignedInteger> order(inputDimension + 1);
+    Point y((inputDimension + 1) * outputDimension_);
+    Point ee(dimension);
+    for (UnsignedInteger b = r.begin(); b != r.end(); ++b)
+    {
+      // Each permutation has its own stream, so results do not depend on the threads
+      RandomStream stream(seed_, b);
+      std::fill(sum.begin(), sum.end(), 0.0);
+      for (UnsignedInteger i = 0; i <= inputDimension; ++i) order[i] = i;
+      for (UnsignedInteger k = 0; k < trajectoryNumber_; ++k)
+      {
+        if (!shuffleOutputs_)
+        {
+          const Scalar sign = (stream.integerGenerate(2) == 0 ? -1.0 : 1.0);
+          const Scalar * effect = effects_ + k * dimension;
+          for (UnsignedInteger j = 0; j < dimension; ++j)
+            sum[j] += sign * effect[j];
+          continue;
+        }
+        // Shuffling the previous order gives a uniform permutation as well
+        for (UnsignedInteger i = inputDimension; i > 0; --i)
+          std::swap(order[i], order[stream.integerGenerate(i + 1)]);
+        const Scalar * outputs = outputs_ + k * (inputDimension + 1) * outputDimension_;
+        if (oneAtATime_[k])
+        {
+          for (UnsignedInteger i = 0; i < inputDimension; ++i)
+          {
+            const Scalar * y0 = outputs + order[i] * outputDimension_;
+            const Scalar * y1 = outputs + order[i + 1] * outputDimension_;
+            const Scalar inverseStep = inverseSteps_[k * inputDimension + i];
+            Scalar * axisSum = &sum[axes_[k * inputDimension + i] * outputDimension_];
+            for (UnsignedInteger j = 0; j < outputDimension_; ++j)
+              axisSum[j] += std::abs(y1[j] - y0[j]) * inverseStep;
+          }
+          continue;
+        }
+        for (UnsignedInteger i = 0; i <= inputDimension; ++i)
+          std::copy(outputs + order[i] * outputDimension_, outputs + (order[i] + 1) * outputDimension_, &y[i * outputDimension_]);
+        SolveTrajectoryEffects(inputs_ + k * (inputDimension + 1) * inputDimension, &y[0], diffBounds_, outputDimension_, &ee[0]);
+        for (UnsignedInteger i = 0; i < inputDimension; ++i)
+          for (UnsignedInteger j = 0; j < outputDimension_; ++j)
+            sum[i * outputDimension_ + j] += std::abs(ee[i + j * inputDimension]);
+      }
+      // Statistics have the layout of the effects
+      Scalar * statistics = statistics_ + b * dimension;
+      for (UnsignedInteger i = 0; i < inputDimension; ++i)
+        for (UnsignedInteger j = 0; j < outputDimension_; ++j)
+        {
+          const Scalar value = (shuffleOutputs_ ? sum[i * outputDimension_ + j] : sum[i + j * inputDimension]);
+          statistics[i + j * inputDimension] = std::abs(value) / trajectoryNumber_;
+        }
+    }
+  }
+
+}; /* end struct PermutationTestPolicy */
+
+/* P-values of the statistics against the absence of effect */
+Sample Morris::computePermutationPValues(const UnsignedInteger permutationNumber, const String & method, const UnsignedInteger seed) const
+{
+  if ((method != "output") && (method != "sign"))
+    throw InvalidArgumentException(HERE) << "In Morris::computePermutationPValues, method should be output or sign, here method=" << method;
+  if (permutationNumber == 0)
+    throw InvalidArgumentException(HERE) << "In Morris::computePermutationPValues, the number of permutations should be positive";
+  const UnsignedInteger stride = computeSampleStride();
+  const UnsignedInteger inputDimension = interval_.getDimension();
+  const UnsignedInteger outputDimension = outputSample_.getDimension();
+  const UnsignedInteger dimension = inputDimension * outputDimension;
+  const Point diffBounds(interval_.getUpperBound() - interval_.getLowerBound());
+  const Bool shuffleOutputs = (method == "output");
+  const Sample elementaryEffects(computeSampleEffects());
+
+  // Trajectories as contiguous blocks, with the axis and step of each move
+  std::vector<Scalar> inputs;
+  std::vector<Scalar> outputs;
+  std::vector<UnsignedInteger> axes;
+  std::vector<Scalar> inverseSteps;
+  std::vector<char> oneAtATime;
+  if (shuffleOutputs)
+  {
+    inputs.resize(trajectoryNumber_ * (inputDimension + 1) * inputDimension);
+    outputs.resize(trajectoryNumber_ * (inputDimension + 1) * outputDimension);
+    axes.resize(trajectoryNumber_ * inputDimension);
+    inverseSteps.resize(trajectoryNumber_ * inputDimension);
+    oneAtATime.resize(trajectoryNumber_);
+    for (UnsignedInteger k = 0; k < trajectoryNumber_; ++k)
+    {
+      Scalar * x = &inputs[k * (inputDimension + 1) * inputDimension];
+      Scalar * y = &outputs[k * (inputDimension + 1) * outputDimension];
+      for (UnsignedInteger i = 0; i <= inputDimension; ++i)
+      {
+        for (UnsignedInteger j = 0; j < inputDimension; ++j)
+          x[i * inputDimension + j] = inputSample_(k * stride + i, j);
+        for (UnsignedInteger j = 0; j < outputDimension; ++j)
+          y[i * outputDimension + j] = outputSample_(k * stride + i, j);
+      }
+      UnsignedInteger * axis = &axes[k * inputDimension];
+      oneAtATime[k] = DetectTrajectoryAxes(x, inputDimension, axis);
+      if (!oneAtATime[k]) continue;
+      for (UnsignedInteger i = 0; i < inputDimension; ++i)
+        inverseSteps[k * inputDimension + i] = diffBounds[axis[i]] / std::abs(x[(i + 1) * inputDimension + axis[i]] - x[i * inputDimension + axis[i]]);
+    }
+  }
+
+  // Statistics of the design, then of each permutation
+  Point observed(dimension);
+  for (UnsignedInteger k = 0; k < trajectoryNumber_; ++k)
+    for (UnsignedInteger j = 0; j < dimension; ++j)
+      observed[j] += (shuffleOutputs ? std::abs(elementaryEffects(k, j)) : elementaryEffects(k, j));
+  for (UnsignedInteger j = 0; j < dimension; ++j)
+    observed[j] = std::abs(observed[j]) / trajectoryNumber_;
+  Sample statistics(permutationNumber, dimension);
+  const PermutationTestPolicy policy(&elementaryEffects(0, 0), inputs.data(), outputs.data(), axes.data(), inverseSteps.data(), oneAtATime.data(),
+                                     diffBounds, trajectoryNumber_, outputDimension, shuffleOutputs, seed, &statistics(0, 0));
+  TBBImplementation::ParallelFor(0, permutationNumber, policy);
+
+  // The design counts as one of the permutations
+  Sample pValues(outputDimension, inputDimension);
+  for (UnsignedInteger j = 0; j < outputDimension; ++j)
+    for (UnsignedInteger i = 0; i < inputDimension; ++i)
+    {
+      const UnsignedInteger index = i + j * inputDimension;
+      UnsignedInteger exceedanceNumber = 1;
+      for (UnsignedInteger b = 0; b < permutationNumber; ++b)
+        if (statistics(b, index) >= observed[index]) ++ exceedanceNumber;
+      pValues(j, i) = (1.0 * exceedanceNumber) / (permutationNumber + 1.0);
+    }
+  LOGINFO(OSS() << "Permutation test with " << permutationNumber << " permutations, p-values=" << pValues);
+  return pValues;
+}
+
+// Indices of the k largest values of each row of the statistics, in decreasing order
+struct TopFactorsPolicy
+{
+  const Sample & statistics_;
+  const UnsignedInteger k_;
+  const Bool absolute_;
+  UnsignedInteger * indices_;
+  Scalar * values_;
+
+  TopFactorsPolicy(const Sample & statistics, const UnsignedInteger k, const Bool absolute, UnsignedInteger * indices, Scalar * values)
+    : statistics_(statistics)
+    , k_(k)
+    , absolute_(absolute)
+    , indices_(indices)
+    , values_(values)
+  {}
+
+  // Larger magnitudes first, ties broken by the input index so that the result is deterministic
+  struct Greater
+  {
+    const Scalar * row_;
+    Bool absolute_;
+    Bool operator()(const UnsignedInteger i, const UnsignedInteger j) const
+    {
+      const Scalar a = (absolute_ ? std::abs(row_[i]) : row_[i]);
+      const Scalar b = (absolute_ ? std::abs(row_[j]) : row_[j]);
+      return (a > b) || ((a == b) && (i < j));
+    }
+  };
+
+  inline void operator()(const TBBImplementation::BlockedRange<UnsignedInteger> & r) const
+  {
+    const UnsignedInteger inputDimension = statistics_.getDimension();
+    std::vector<UnsignedInteger> order(inputDimension);
+    for (UnsignedInteger marginal = r.begin(); marginal != r.end(); ++marginal)
+    {
+      const Greater greater = {&statistics_(marginal, 0), absolute_};
+      for (UnsignedInteger i = 0; i < inputDimension; ++i) order[i] = i;
+      // Linear selection of the k largest, then sort of these only
+      if (k_ < inputDimension)
+        std::nth_element(order.begin(), order.begin() + k_, order.end(), greater);
+      std::sort(order.begin(), order.begin() + k_, greater);
+      for (UnsignedInteger i = 0; i < k_; ++i)
+      {
+        indices_[marginal * k_ + i] = order[i];
+        values_[marginal * k_ + i] = statistics_(marginal, order[i]);
+      }
+    }
+  }
+
+}; /* end struct TopFactorsPolicy */
+
+/* Partial selection of the k largest statistics of each output */
+void Morris::computeTopFactors(const UnsignedInteger k, const String & statistic, Indices & indices, Sample & values) const
+{
+  const UnsignedInteger inputDimension = interval_.getDimension();
+  if ((k == 0) || (k > inputDimension))
+    throw InvalidArgumentException(HERE) << "In Morris, the number of factors should be in [1, " << inputDimension << "], here k=" << k;
+  const Sample * statistics = 0;
+  if (statistic == "mu*") statistics = &absoluteElementaryEffectsMean_;
+  else if (statistic == "mu") statistics = &elementaryEffectsMean_;
+  else if (statistic == "sigma") statistics = &elementaryEffectsStandardDeviation_;
+  else
+    throw InvalidArgumentException(HERE) << "In Morris, statistic should be mu*, mu or sigma, here statistic=" << statistic;
+  const UnsignedInteger outputDimension = statistics->getSize();
+  indices = Indices(outputDimension * k);
+  values = Sample(outputDimension, k);
+  if (outputDimension == 0) return;
+  const TopFactorsPolicy policy(*statistics, k, statistic == "mu", &indices[0], &values(0, 0));
+  TBBImplementation::ParallelFor(0, outputDimension, policy);
+}
+
+/* Inputs with the k largest statistics for each output */
+Indices Morris::getTopFactors(const UnsignedInteger k, const String & statistic) const
+{
+  Indices indices;
+  Sample values;
+  computeTopFactors(k, statistic, indices, values);
+  return indices;
+}
+
+Sample Morris::getTopFactorValues(const UnsignedInteger k, const String & statistic) const
+{
+  Indices indices;
+  Sample values;
+  computeTopFactors(k, statistic, indices, values);
+  return values;
+}
+
+// Indicators of the exceedance of each threshold by one output, rows being processed in parallel
+struct ThresholdTransformPolicy
+{
+  const Sample & outputSample_;
+  const UnsignedInteger outputMarginal_;
+  const Point & thresholds_;
+  const Scalar bandwidth_;
+  Sample & indicators_;
+
+  ThresholdTransformPolicy(const Sample & outputSample, const UnsignedInteger outputMarginal,
+                           const Point & thresholds, const Scalar bandwidth, Sample & indicators)
+    : outputSample_(outputSample)
+    , outputMarginal_(outputMarginal)
+    , thresholds_(thresholds)
+    , bandwidth_(bandwidth)
+    , indicators_(indicators)
+  {}
+
+  inline void operator()(const TBBImplementation::BlockedRange<UnsignedInteger> & r) const
+  {
+    const UnsignedInteger thresholdNumber = thresholds_.getDimension();
+    const Scalar * thresholds = &thresholds_[0];
+    for (UnsignedInteger i = r.begin(); i != r.end(); ++i)
+    {
+      // Each output is read once for all the thresholds
+      const Scalar y = outputSample_(i, outputMarginal_);
+      Scalar * indicators = &indicators_(i, 0);
+      if (bandwidth_ > 0.0)
+      {
+        const Scalar scale = 1.0 / bandwidth_;
+        for (UnsignedInteger j = 0; j < thresholdNumber; ++j)
+          indicators[j] = 1.0 / (1.0 + std::exp((thresholds[j] - y) * scale));
+      }
+      else
+        for (UnsignedInteger j = 0; j < thresholdNumber; ++j)
+          indicators[j] = (y > thresholds[j] ? 1.0 : 0.0);
+    }
+  }
+
+}; /* end struct ThresholdTransformPolicy */
+
+/* Analysis of the indicators 1{y > t} of an output, smoothed if bandwidth > 0, one output per threshold */
+Morris Morris::computeThresholdAnalysis(const Point & thresholds, const UnsignedInteger outputMarginal, const Scalar bandwidth) const
+{
+  if (outputMarginal >= elementaryEffectsMean_.getSize()) throw InvalidArgumentException(HERE) << "Cannot exceed dimension";
+  const UnsignedInteger thresholdNumber = thresholds.getDimension();
+  if (thresholdNumber == 0)
+    throw InvalidArgumentException(HERE) << "In Morris::computeThresholdAnalysis, at least one threshold is needed";
+  if (!(bandwidth >= 0.0))
+    throw InvalidArgumentException(HERE) << "In Morris::computeThresholdAnalysis, the bandwidth should be non-negative, here bandwidth=" << bandwidth;
+  const UnsignedInteger stride = computeSampleStride();
+  Sample indicators(outputSample_.getSize(), thresholdNumber);
+  const ThresholdTransformPolicy policy(outputSample_, outputMarginal, thresholds, bandwidth, indicators);
+  TBBImplementation::ParallelFor(0, outputSample_.getSize(), policy);
+
+  // The trajectories are the ones of the samples, only the outputs change
+  Morris analysis(interval_, thresholdNumber);
+  analysis.singlePrecision_ = singlePrecision_;
+  analysis.computeEffects(inputSample_, indicators, stride);
+  analysis.inputSample_ = inputSample_;
+  Description description(thresholdNumber);
+  String name(outputSample_.getDescription()[outputMarginal]);
+  if (name.empty()) name = OSS() << "y" << outputMarginal;
+  for (UnsignedInteger j = 0; j < thresholdNumber; ++j)
+    description[j] = OSS() << "1{" << name << ">" << thresholds[j] << "}";
+  indicators.setDescription(description);
+  analysis.outputSample_ = indicators;
+  return analysis;
+}
+
+// Centers and scales columns of a column-major buffer to unit norm, replacing the values by their mid-ranks first if needed
+struct StandardizeColumnsPolicy
+{
+  Scalar * columns_;
+  const UnsignedInteger size_;
+  const Bool rank_;
+  char * constant_;
+
+  StandardizeColumnsPolicy(Scalar * columns, const UnsignedInteger size, const Bool rank, char * constant)
+    : columns_(columns)
+    , size_(size)
+    , rank_(rank)
+    , constant_(constant)
+  {}
+
+  inline void operator()(const TBBImplementation::BlockedRange<UnsignedInteger> & r) const
+  {
+    std::vector<UnsignedInteger> order(rank_ ? size_ : 0);
+    for (UnsignedInteger j = r.begin(); j != r.end(); ++j)
+    {
+      Scalar * column = columns_ + j * size_;
+      if (rank_)
+      {
+        // Ties, frequent on grid designs, share their mean rank
+        for (UnsignedInteger i = 0; i < size_; ++i) order[i] = i;
+        std::sort(order.begin(), order.end(), [column](const UnsignedInteger a, const UnsignedInteger b)
+        {
+          return column[a] < column[b];
+        });
+        UnsignedInteger first = 0;
+        while (first < size_)
+        {
+          UnsignedInteger last = first + 1;
+          while ((last < size_) && (column[order[last]] == column[order[first]])) ++ last;
+          const Scalar meanRank = 0.5 * (first + last - 1);
+          for (UnsignedInteger i = first; i < last; ++i) column[order[i]] = meanRank;
+          first = last;
+        }
+      }
+      Scalar mean = 0.0;
+      for (UnsignedInteger i = 0; i < size_; ++i) mean += column[i];
+      mean /= size_;
+      Scalar squaredNorm = 0.0;
+      for (UnsignedInteger i = 0; i < size_; ++i)
+      {
+        column[i] -= mean;
+        squaredNorm += column[i] * column[i];
+      }
+      constant_[j] = !(squaredNorm > 0.0);
+      const Scalar scale = (constant_[j] ? 0.0 : 1.0 / std::sqrt(squaredNorm));
+      for (UnsignedInteger i = 0; i < size_; ++i) column[i] *= scale;
+    }
+  }
+
+}; /* end struct StandardizeColumnsPolicy */
+
+// Dot products between the columns of two column-major buffers, the lower triangle only if both are the same
+struct CrossProductPolicy
+{
+  const Scalar * left_;
+  const UnsignedInteger leftNumber_;
+  const Scalar * right_;
+  const UnsignedInteger size_;
+  const Bool symmetric_;
+  Scalar * products_;
+
+  CrossProductPolicy(const Scalar * left, const UnsignedInteger leftNumber, const Scalar * right,
+                     const UnsignedInteger size, const Bool symmetric, Scalar * products)
+    : left_(left)
+    , leftNumber_(leftNumber)
+    , right_(right)
+    , size_(size)
+    , symmetric_(symmetric)
+    , products_(products)
+  {}
+
+  inline void operator()(const TBBImplementation::BlockedRange<UnsignedInteger> & r) const
+  {
+    for (UnsignedInteger k = r.begin(); k != r.end(); ++k)
+    {
+      const Scalar * right = right_ + k * size_;
+      for (UnsignedInteger i = (symmetric_ ? k : 0); i < leftNumber_; ++i)
+      {
+        const Scalar * left = left_ + i * size_;
+        Scalar product = 0.0;
+        for (UnsignedInteger n = 0; n < size_; ++n) product += left[n] * right[n];
+        products_[i + k * leftNumber_] = product;
+      }
+    }
+  }
+
+}; /* end struct CrossProductPolicy */
+
+// Linear regression of the standardized outputs on the standardized inputs of the samples
+void Morris::computeRegression(const Bool rank, Sample & coefficients, Point & determination) const
+{
+  checkSamples();
+  const UnsignedInteger size = inputSample_.getSize();
+  const UnsignedInteger inputDimension = interval_.getDimension();
+  const UnsignedInteger outputDimension = outputSample_.getDimension();
+  if (size <= inputDimension)
+    throw InvalidArgumentException(HERE) << "In Morris, the regression needs more than " << inputDimension << " points, here " << size;
+
+  // Column-major copies, so that each product runs over contiguous values
+  std::vector<Scalar> inputs(size * inputDimension);
+  std::vector<Scalar> outputs(size * outputDimension);
+  for (UnsignedInteger n = 0; n < size; ++n)
+  {
+    for (UnsignedInteger i = 0; i < inputDimension; ++i)
+      inputs[n + i * size] = inputSample_(n, i);
+    for (UnsignedInteger j = 0; j < outputDimension; ++j)
+      outputs[n + j * size] = outputSample_(n, j);
+  }
+  std::vector<char> constantInputs(inputDimension);
+  std::vector<char> constantOutputs(outputDimension);
+  TBBImplementation::ParallelFor(0, inputDimension, StandardizeColumnsPolicy(inputs.data(), size, rank, constantInputs.data()));
+  TBBImplementation::ParallelFor(0, outputDimension, StandardizeColumnsPolicy(outputs.data(), size, rank, constantOutputs.data()));
+  for (UnsignedInteger i = 0; i < inputDimension; ++i)
+    if (constantInputs[i])
+      throw InvalidArgumentException(HERE) << "In Morris, the regression needs varying inputs, here input " << i << " is constant";
+
+  // Normal equations on the correlation matrix, one factorization for all the outputs
+  std::vector<Scalar> products(inputDimension * inputDimension);
+  TBBImplementation::ParallelFor(0, inputDimension, CrossProductPolicy(inputs.data(), inputDimension, inputs.data(), size, true, products.data()));
+  SymmetricMatrix gram(inputDimension);
+  for (UnsignedInteger k = 0; k < inputDimension; ++k)
+    for (UnsignedInteger i = k; i < inputDimension; ++i)
+      gram(i, k) = products[i + k * inputDimension];
+  Matrix rightHandSides(inputDimension, outputDimension);
+  TBBImplementation::ParallelFor(0, outputDimension, CrossProductPolicy(inputs.data(), inputDimension, outputs.data(), size, false, &rightHandSides(0, 0)));
+  const Matrix solution(gram.solveLinearSystem(rightHandSides));
+
+  coefficients = Sample(outputDimension, inputDimension);
+  determination = Point(outputDimension);
+  for (UnsignedInteger j = 0; j < outputDimension; ++j)
+  {
+    // Constant outputs have no coefficient
+    if (constantOutputs[j]) continue;
+    for (UnsignedInteger i = 0; i < inputDimension; ++i)
+    {
+      coefficients(j, i) = solution(i, j);
+      determination[j] += solution(i, j) * rightHandSides(i, j);
+    }
+  }
+  LOGINFO(OSS() << "Regression of " << outputDimension << " outputs on " << size << " points, R2=" << determination);
+}
+
+/* Standardized regression coefficients of the outputs on the inputs of the samples, of their ranks if rank is true, one row per output */
+Sample Morris::computeStandardRegressionCoefficients(const Bool rank) const
+{
+  Sample coefficients;
+  Point determination;
+  computeRegression(rank, coefficients, determination);
+  return coefficients;
+}
+
+/* Coefficient of determination R^2 of the regression of each output */
+Point Morris::computeRegressionDetermination(const Bool rank) const
+{
+  Sample coefficients;
+  Point determination;
+  computeRegression(rank, coefficients, determination);
+  return determination;
+}
+
+/* Standard deviation of the outputs of the trajectories */
+Point Morris::getOutputStandardDeviation() const
+{
+  if (outputSize_ < 2)
+    throw InternalException(HERE) << "In Morris, the moments of the outputs are not available";
+  Point standardDeviation(outputSquaredDeviations_.getDimension());
+  for (UnsignedInteger j = 0; j < standardDeviation.getDimension(); ++j)
+    standardDeviation[j] = std::sqrt(outputSquaredDeviations_[j] / (outputSize_ - 1.0));
+  return standardDeviation;
+}
+
+/* mu* divided by the standard deviation of the output */
+Point Morris::getScaledMeanAbsoluteElementaryEffects(const UnsignedInteger marginal) const
+{
+  if (marginal >= absoluteElementaryEffectsMean_.getSize()) throw InvalidArgumentException(HERE) << "Cannot exceed dimension";
+  const Scalar outputStandardDeviation = getOutputStandardDeviation()[marginal];
+  if (!(outputStandardDeviation > 0.0))
+    throw InvalidArgumentException(HERE) << "In Morris, output " << marginal << " is constant";
+  Point scaled(absoluteElementaryEffectsMean_[marginal]);
+  scaled /= outputStandardDeviation;
+  return scaled;
+}
+
+/* mu* scaled by the standard deviation of the inputs uniform over the interval */
+Point Morris::getNormalizedMeanAbsoluteElementaryEffects(const UnsignedInteger marginal) const
+{
+  // Effects are per width of the interval, whose uniform standard deviation is width / sqrt(12)
+  Point normalized(getScaledMeanAbsoluteElementaryEffects(marginal));
+  normalized /= std::sqrt(12.0);
+  return normalized;
+}
+
+/* mu* scaled by the standard deviation of the inputs given by a distribution */
+Point Morris::getNormalizedMeanAbsoluteElementaryEffects(const Distribution & distribution, const UnsignedInteger marginal) const
+{
+  const UnsignedInteger inputDimension = interval_.getDimension();
+  if (distribution.getDimension() != inputDimension)
+    throw InvalidArgumentException(HERE) << "In Morris, expected a distribution of dimension " << inputDimension
+                                         << ", here dimension=" << distribution.getDimension();
+  const Point inputStandardDeviation(distribution.getStandardDeviation());
+  const Point diffBounds(interval_.getUpperBound() - interval_.getLowerBound());
+  Point normalized(getScaledMeanAbsoluteElementaryEffects(marginal));
+  for (UnsignedInteger i = 0; i < inputDimension; ++i)
+    normalized[i] *= inputStandardDeviation[i] / diffBounds[i];
+  return normalized;
+}
+
 /* String converter */
 String Morris::__repr__() const
 {
+  loadSamples();
   OSS oss;
   oss << "class=" << Morris::GetClassName()
       << ", input sample=" << inputSample_
@@ -189,24 +1846,334 @@ String Morris::__repr__() const
 
 Sample Morris::getInputSample() const
 {
+  loadSamples();
   return inputSample_;
 }
 
 Sample Morris::getOutputSample() const
 {
+  loadSamples();
   return outputSample_;
 }
 
+/* Store the object into a compact binary file, samples being optional */
+void Morris::saveBinary(const FileName & fileName, const Bool saveSamples) const
+{
+  std::ofstream file(fileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file)
+    throw FileOpenException(HERE) << "Cannot open file " << fileName << " for writing";
+  saveBinary(file, saveSamples);
+  if (!file)
+    throw FileOpenException(HERE) << "Error while writing into file " << fileName;
+}
+
+/* Store the object into a binary stream, samples being optional */
+void Morris::saveBinary(std::ostream & stream, const Bool saveSamples) const
+{
+  loadSamples();
+  const UnsignedInteger inputDimension = interval_.getDimension();
+  const UnsignedInteger outputDimension = elementaryEffectsMean_.getSize();
+  const UnsignedInteger sampleSize = (saveSamples ? inputSample_.getSize() : 0);
+  std::uint64_t header[HEADERSIZE];
+  header[VERSION] = BinaryVersion;
+  header[FLAGS] = (sampleSize > 0 ? BinaryWithSamples | BinaryWithDescriptions : 0) | (singlePrecision_ ? BinarySinglePrecision : 0) | (outputDimension_ > 0 ? BinaryIngestion : 0);
+  header[INPUTDIMENSION] = inputDimension;
+  header[OUTPUTDIMENSION] = outputDimension;
+  header[TRAJECTORYNUMBER] = trajectoryNumber_;
+  header[SAMPLESIZE] = sampleSize;
+  stream.write(BinaryMagic, sizeof(BinaryMagic));
+  stream.write(reinterpret_cast<const char *>(header), sizeof(header));
+  const Point lowerBound(interval_.getLowerBound());
+  const Point upperBound(interval_.getUpperBound());
+  stream.write(reinterpret_cast<const char *>(&lowerBound[0]), inputDimension * sizeof(Scalar));
+  stream.write(reinterpret_cast<const char *>(&upperBound[0]), inputDimension * sizeof(Scalar));
+  // Statistics are q x p samples, stored contiguously
+  if (outputDimension > 0)
+  {
+    const UnsignedInteger statisticsSize = outputDimension * inputDimension * sizeof(Scalar);
+    stream.write(reinterpret_cast<const char *>(&elementaryEffectsMean_(0, 0)), statisticsSize);
+    stream.write(reinterpret_cast<const char *>(&absoluteElementaryEffectsMean_(0, 0)), statisticsSize);
+    stream.write(reinterpret_cast<const char *>(&elementaryEffectsStandardDeviation_(0, 0)), statisticsSize);
+    stream.write(reinterpret_cast<const char *>(&elementaryEffectsSquaredDeviations_(0, 0)), statisticsSize);
+    // Moments of the outputs, since version 2
+    const std::uint64_t outputSize = outputSize_;
+    const Point outputMean(outputSize_ > 0 ? outputMean_ : Point(outputDimension));
+    const Point outputSquaredDeviations(outputSize_ > 0 ? outputSquaredDeviations_ : Point(outputDimension));
+    stream.write(reinterpret_cast<const char *>(&outputSize), sizeof(outputSize));
+    stream.write(reinterpret_cast<const char *>(&outputMean[0]), outputDimension * sizeof(Scalar));
+    stream.write(reinterpret_cast<const char *>(&outputSquaredDeviations[0]), outputDimension * sizeof(Scalar));
+  }
+  // Results added in any order, since version 3
+  if (outputDimension_ > 0)
+  {
+    const std::uint64_t ingestion[5] = {seed_, outputDimension_, completed_.size(), pending_.size(), experiment_.isNull() ? 0U : 1U};
+    stream.write(reinterpret_cast<const char *>(ingestion), sizeof(ingestion));
+    const std::vector<char> completed(completed_.begin(), completed_.end());
+    if (!completed.empty()) stream.write(&completed[0], completed.size());
+    if (!experiment_.isNull())
+    {
+      const String className(experiment_->getClassName());
+      const std::uint64_t length = className.size();
+      stream.write(reinterpret_cast<const char *>(&length), sizeof(length));
+      stream.write(className.c_str(), length);
+      experiment_->saveBinary(stream);
+    }
+    for (PendingTrajectoryMap::const_iterator it = pending_.begin(); it != pending_.end(); ++it)
+    {
+      const std::uint64_t index = it->first;
+      const std::vector<char> received(it->second.received_.begin(), it->second.received_.end());
+      stream.write(reinterpret_cast<const char *>(&index), sizeof(index));
+      stream.write(&received[0], inputDimension + 1);
+      stream.write(reinterpret_cast<const char *>(&it->second.output_(0, 0)), (inputDimension + 1) * outputDimension_ * sizeof(Scalar));
+      if (experiment_.isNull())
+        stream.write(reinterpret_cast<const char *>(&it->second.input_(0, 0)), (inputDimension + 1) * inputDimension * sizeof(Scalar));
+    }
+  }
+  if (sampleSize == 0) return;
+  // Descriptions of the columns as length-prefixed strings
+  const Description description(inputSample_.getDescription());
+  const Description outputDescription(outputSample_.getDescription());
+  for (UnsignedInteger j = 0; j < inputDimension + outputDimension; ++j)
+  {
+    const String name(j < inputDimension ? description[j] : outputDescription[j - inputDimension]);
+    const std::uint64_t length = name.size();
+    stream.write(reinterpret_cast<const char *>(&length), sizeof(length));
+    stream.write(name.c_str(), length);
+  }
+  // Samples are written column by column
+  Point column(sampleSize);
+  for (UnsignedInteger j = 0; j < inputDimension + outputDimension; ++j)
+  {
+    for (UnsignedInteger i = 0; i < sampleSize; ++i)
+      column[i] = (j < inputDimension ? inputSample_(i, j) : outputSample_(i, j - inputDimension));
+    stream.write(reinterpret_cast<const char *>(&column[0]), sampleSize * sizeof(Scalar));
+  }
+}
+
+/* Reload an object stored by saveBinary, samples being read on first access */
+Morris Morris::LoadBinary(const FileName & fileName)
+{
+  std::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+  if (!file)
+    throw FileOpenException(HERE) << "Cannot open file " << fileName;
+  return ReadBinary(file, fileName);
+}
+
+/* Reload an object stored by saveBinary from a binary stream */
+Morris Morris::LoadBinary(std::istream & stream)
+{
+  return ReadBinary(stream, FileName());
+}
+
+/* Read a binary stream, samples being read on first access from sampleFileName if given */
+Morris Morris::ReadBinary(std::istream & stream, const FileName & sampleFileName)
+{
+  char magic[sizeof(BinaryMagic)];
+  std::uint64_t header[HEADERSIZE];
+  stream.read(magic, sizeof(magic));
+  stream.read(reinterpret_cast<char *>(header), sizeof(header));
+  if (!stream || (std::memcmp(magic, BinaryMagic, sizeof(BinaryMagic)) != 0))
+    throw FileNotFoundException(HERE) << "In Morris::LoadBinary, not a Morris binary file";
+  if (header[VERSION] > BinaryVersion)
+    throw NotYetImplementedException(HERE) << "In Morris::LoadBinary, got version " << header[VERSION]
+                                           << ", only versions up to " << BinaryVersion << " are supported";
+  const UnsignedInteger inputDimension = header[INPUTDIMENSION];
+  const UnsignedInteger outputDimension = header[OUTPUTDIMENSION];
+  Morris morris;
+  morris.trajectoryNumber_ = header[TRAJECTORYNUMBER];
+  morris.singlePrecision_ = ((header[FLAGS] & BinarySinglePrecision) != 0);
+  Point lowerBound(inputDimension);
+  Point upperBound(inputDimension);
+  stream.read(reinterpret_cast<char *>(&lowerBound[0]), inputDimension * sizeof(Scalar));
+  stream.read(reinterpret_cast<char *>(&upperBound[0]), inputDimension * sizeof(Scalar));
+  morris.interval_ = Interval(lowerBound, upperBound);
+  morris.elementaryEffectsMean_ = Sample(outputDimension, inputDimension);
+  morris.absoluteElementaryEffectsMean_ = Sample(outputDimension, inputDimension);
+  morris.elementaryEffectsStandardDeviation_ = Sample(outputDimension, inputDimension);
+  morris.elementaryEffectsSquaredDeviations_ = Sample(outputDimension, inputDimension);
+  if (outputDimension > 0)
+  {
+    const UnsignedInteger statisticsSize = outputDimension * inputDimension * sizeof(Scalar);
+    stream.read(reinterpret_cast<char *>(&morris.elementaryEffectsMean_(0, 0)), statisticsSize);
+    stream.read(reinterpret_cast<char *>(&morris.absoluteElementaryEffectsMean_(0, 0)), statisticsSize);
+    stream.read(reinterpret_cast<char *>(&morris.elementaryEffectsStandardDeviation_(0, 0)), statisticsSize);
+    stream.read(reinterpret_cast<char *>(&morris.elementaryEffectsSquaredDeviations_(0, 0)), statisticsSize);
+    if (header[VERSION] >= 2)
+    {
+      std::uint64_t outputSize = 0;
+      morris.outputMean_ = Point(outputDimension);
+      morris.outputSquaredDeviations_ = Point(outputDimension);
+      stream.read(reinterpret_cast<char *>(&outputSize), sizeof(outputSize));
+      stream.read(reinterpret_cast<char *>(&morris.outputMean_[0]), outputDimension * sizeof(Scalar));
+      stream.read(reinterpret_cast<char *>(&morris.outputSquaredDeviations_[0]), outputDimension * sizeof(Scalar));
+      morris.outputSize_ = outputSize;
+    }
+  }
+  if (!stream)
+    throw FileNotFoundException(HERE) << "In Morris::LoadBinary, truncated statistics";
+  if (header[FLAGS] & BinaryIngestion)
+  {
+    std::uint64_t ingestion[5];
+    stream.read(reinterpret_cast<char *>(ingestion), sizeof(ingestion));
+    if (!stream)
+      throw FileNotFoundException(HERE) << "In Morris::LoadBinary, truncated results";
+    morris.seed_ = ingestion[0];
+    morris.outputDimension_ = ingestion[1];
+    std::vector<char> completed(ingestion[2]);
+    if (!completed.empty()) stream.read(&completed[0], completed.size());
+    morris.completed_.assign(completed.begin(), completed.end());
+    if (ingestion[4])
+    {
+      std::uint64_t length = 0;
+      stream.read(reinterpret_cast<char *>(&length), sizeof(length));
+      String className(length, ' ');
+      if (length > 0) stream.read(&className[0], length);
+      if (!stream)
+        throw FileNotFoundException(HERE) << "In Morris::LoadBinary, truncated experiment";
+      morris.experiment_ = BuildExperiment(className);
+      morris.experiment_->loadBinary(stream);
+    }
+    for (UnsignedInteger k = 0; k < ingestion[3]; ++k)
+    {
+      std::uint64_t index = 0;
+      std::vector<char> received(inputDimension + 1);
+      PendingTrajectory trajectory;
+      trajectory.output_ = Sample(inputDimension + 1, morris.outputDimension_);
+      stream.read(reinterpret_cast<char *>(&index), sizeof(index));
+      stream.read(&received[0], inputDimension + 1);
+      stream.read(reinterpret_cast<char *>(&trajectory.output_(0, 0)), (inputDimension + 1) * morris.outputDimension_ * sizeof(Scalar));
+      if (morris.experiment_.isNull())
+      {
+        trajectory.input_ = Sample(inputDimension + 1, inputDimension);
+        stream.read(reinterpret_cast<char *>(&trajectory.input_(0, 0)), (inputDimension + 1) * inputDimension * sizeof(Scalar));
+      }
+      trajectory.received_ = Indices(received.begin(), received.end());
+      trajectory.receivedNumber_ = std::count(received.begin(), received.end(), 1);
+      morris.pending_[index] = trajectory;
+    }
+    if (!stream)
+      throw FileNotFoundException(HERE) << "In Morris::LoadBinary, truncated results";
+    morris.missingSamplesReason_ = "the results are added one point at a time";
+  }
+  else if (!(header[FLAGS] & BinaryWithSamples) && (morris.trajectoryNumber_ > 0))
+    morris.missingSamplesReason_ = "the samples were not saved";
+  if (!(header[FLAGS] & BinaryWithSamples)) return morris;
+  // Samples of files are only read when they are accessed
+  if (!sampleFileName.empty())
+  {
+    morris.sampleFileName_ = sampleFileName;
+    morris.sampleOffset_ = static_cast<UnsignedInteger>(stream.tellg());
+  }
+  else
+    ReadSamples(stream, header[SAMPLESIZE], header[INPUTDIMENSION], header[OUTPUTDIMENSION], (header[FLAGS] & BinaryWithDescriptions) != 0, morris.inputSample_, morris.outputSample_);
+  return morris;
+}
+
+/* Read the column blocks of the samples */
+void Morris::ReadSamples(std::istream & stream, const UnsignedInteger sampleSize, const UnsignedInteger inputDimension, const UnsignedInteger outputDimension,
+                         const Bool withDescriptions, Sample & inputSample, Sample & outputSample)
+{
+  inputSample = Sample(sampleSize, inputDimension);
+  outputSample = Sample(sampleSize, outputDimension);
+  // Descriptions, since version 3
+  if (withDescriptions)
+  {
+    Description description(inputDimension);
+    Description outputDescription(outputDimension);
+    for (UnsignedInteger j = 0; j < inputDimension + outputDimension; ++j)
+    {
+      std::uint64_t length = 0;
+      stream.read(reinterpret_cast<char *>(&length), sizeof(length));
+      if (!stream)
+        throw FileNotFoundException(HERE) << "In Morris::LoadBinary, truncated descriptions";
+      String name(length, ' ');
+      if (length > 0) stream.read(&name[0], length);
+      if (j < inputDimension) description[j] = name;
+      else outputDescription[j - inputDimension] = name;
+    }
+    inputSample.setDescription(description);
+    outputSample.setDescription(outputDescription);
+  }
+  Point column(sampleSize);
+  for (UnsignedInteger j = 0; j < inputDimension + outputDimension; ++j)
+  {
+    if (sampleSize == 0) break;
+    stream.read(reinterpret_cast<char *>(&column[0]), sampleSize * sizeof(Scalar));
+    for (UnsignedInteger i = 0; i < sampleSize; ++i)
+    {
+      if (j < inputDimension) inputSample(i, j) = column[i];
+      else outputSample(i, j - inputDimension) = column[i];
+    }
+  }
+  if (!stream)
+    throw FileNotFoundException(HERE) << "In Morris::LoadBinary, truncated samples";
+}
+
+/* Read the samples of a binary file on first access */
+void Morris::loadSamples() const
+{
+  if (sampleFileName_.empty()) return;
+  std::ifstream file(sampleFileName_.c_str(), std::ios::in | std::ios::binary);
+  if (!file)
+    throw FileOpenException(HERE) << "Cannot open file " << sampleFileName_;
+  std::uint64_t header[HEADERSIZE];
+  file.seekg(sizeof(BinaryMagic));
+  file.read(reinterpret_cast<char *>(header), sizeof(header));
+  Sample inputSample;
+  Sample outputSample;
+  file.seekg(sampleOffset_);
+  ReadSamples(file, header[SAMPLESIZE], header[INPUTDIMENSION], header[OUTPUTDIMENSION], (header[FLAGS] & BinaryWithDescriptions) != 0, inputSample, outputSample);
+  LOGINFO(OSS() << "Read samples of size " << inputSample.getSize() << " from " << sampleFileName_);
+  inputSample_ = inputSample;
+  outputSample_ = outputSample;
+  sampleFileName_ = FileName();
+}
 
 /* Method save() stores the object through the StorageManager */
 void Morris::save(Advocate & adv) const
 {
+  loadSamples();
   PersistentObject::save( adv );
   adv.saveAttribute( "inputSample_", inputSample_ );
   adv.saveAttribute( "outputSample_", outputSample_ );
+  adv.saveAttribute( "interval_", interval_ );
   adv.saveAttribute( "elementaryEffectsMean_", elementaryEffectsMean_ );
   adv.saveAttribute( "elementaryEffectsStandardDeviation_", elementaryEffectsStandardDeviation_ );
   adv.saveAttribute( "absoluteElementaryEffectsMean_", absoluteElementaryEffectsMean_ );
+  adv.saveAttribute( "elementaryEffectsSquaredDeviations_", elementaryEffectsSquaredDeviations_ );
+  adv.saveAttribute( "trajectoryNumber_", trajectoryNumber_ );
+  adv.saveAttribute( "outputMean_", outputMean_ );
+  adv.saveAttribute( "outputSquaredDeviations_", outputSquaredDeviations_ );
+  adv.saveAttribute( "outputSize_", outputSize_ );
+  adv.saveAttribute( "singlePrecision_", singlePrecision_ );
+  adv.saveAttribute( "missingSamplesReason_", missingSamplesReason_ );
+  // Results added in any order, pending trajectories being stacked
+  adv.saveAttribute( "seed_", seed_ );
+  adv.saveAttribute( "outputDimension_", outputDimension_ );
+  Indices completed(completed_.size());
+  for (UnsignedInteger k = 0; k < completed_.size(); ++k)
+    completed[k] = completed_[k];
+  adv.saveAttribute( "completed_", completed );
+  const UnsignedInteger inputDimension = interval_.getDimension();
+  Indices pendingIndices(0);
+  Indices pendingReceived(0);
+  Sample pendingInput(0, inputDimension);
+  Sample pendingOutput(0, outputDimension_);
+  for (PendingTrajectoryMap::const_iterator it = pending_.begin(); it != pending_.end(); ++it)
+  {
+    pendingIndices.add(it->first);
+    pendingReceived.add(it->second.received_);
+    if (experiment_.isNull())
+      pendingInput.add(it->second.input_);
+    pendingOutput.add(it->second.output_);
+  }
+  adv.saveAttribute( "pendingIndices_", pendingIndices );
+  adv.saveAttribute( "pendingReceived_", pendingReceived );
+  adv.saveAttribute( "pendingInput_", pendingInput );
+  adv.saveAttribute( "pendingOutput_", pendingOutput );
+  adv.saveAttribute( "experimentClassName_", experiment_.isNull() ? String() : experiment_->getClassName() );
+  if (!experiment_.isNull())
+    adv.saveAttribute( "experiment_", *experiment_ );
 }
 
 /* Method load() reloads the object from the StorageManager */
@@ -218,6 +2185,85 @@ void Morris::load(Advocate & adv)
   adv.loadAttribute( "elementaryEffectsMean_", elementaryEffectsMean_ );
   adv.loadAttribute( "elementaryEffectsStandardDeviation_", elementaryEffectsStandardDeviation_ );
   adv.loadAttribute( "absoluteElementaryEffectsMean_", absoluteElementaryEffectsMean_ );
+  // Older studies only hold the samples and the statistics, the rest is rebuilt from them
+  if (adv.hasAttribute( "interval_" ))
+    adv.loadAttribute( "interval_", interval_ );
+  else if (inputSample_.getSize() > 0)
+    interval_ = Interval(inputSample_.getMin(), inputSample_.getMax());
+  else
+    interval_ = Interval(elementaryEffectsMean_.getDimension());
+  const UnsignedInteger inputDimension = interval_.getDimension();
+  if (adv.hasAttribute( "trajectoryNumber_" ))
+    adv.loadAttribute( "trajectoryNumber_", trajectoryNumber_ );
+  else
+    trajectoryNumber_ = inputSample_.getSize() / (inputDimension + 1);
+  if (adv.hasAttribute( "elementaryEffectsSquaredDeviations_" ))
+    adv.loadAttribute( "elementaryEffectsSquaredDeviations_", elementaryEffectsSquaredDeviations_ );
+  else
+  {
+    elementaryEffectsSquaredDeviations_ = Sample(elementaryEffectsStandardDeviation_.getSize(), inputDimension);
+    for (UnsignedInteger i = 0; i < elementaryEffectsSquaredDeviations_.getSize(); ++i)
+      for (UnsignedInteger j = 0; j < inputDimension; ++j)
+        elementaryEffectsSquaredDeviations_(i, j) = elementaryEffectsStandardDeviation_(i, j) * elementaryEffectsStandardDeviation_(i, j) * (trajectoryNumber_ - 1.0);
+  }
+  outputSize_ = 0;
+  if (adv.hasAttribute( "outputSize_" ))
+  {
+    adv.loadAttribute( "outputMean_", outputMean_ );
+    adv.loadAttribute( "outputSquaredDeviations_", outputSquaredDeviations_ );
+    adv.loadAttribute( "outputSize_", outputSize_ );
+  }
+  else if (outputSample_.getSize() > 0)
+  {
+    Point absoluteMean;
+    outputSize_ = outputSample_.getSize();
+    ComputeBlockedMoments(&outputSample_(0, 0), outputSize_, outputSample_.getDimension(), outputMean_, absoluteMean, outputSquaredDeviations_);
+  }
+  singlePrecision_ = false;
+  if (adv.hasAttribute( "singlePrecision_" ))
+    adv.loadAttribute( "singlePrecision_", singlePrecision_ );
+  missingSamplesReason_ = "";
+  if (adv.hasAttribute( "missingSamplesReason_" ))
+    adv.loadAttribute( "missingSamplesReason_", missingSamplesReason_ );
+  seed_ = 0;
+  outputDimension_ = 0;
+  pending_.clear();
+  completed_.clear();
+  experiment_ = Pointer<MorrisExperiment>();
+  if (adv.hasAttribute( "outputDimension_" ))
+  {
+    adv.loadAttribute( "seed_", seed_ );
+    adv.loadAttribute( "outputDimension_", outputDimension_ );
+    Indices completed;
+    adv.loadAttribute( "completed_", completed );
+    completed_.assign(completed.begin(), completed.end());
+    String experimentClassName;
+    adv.loadAttribute( "experimentClassName_", experimentClassName );
+    if (!experimentClassName.empty())
+    {
+      experiment_ = BuildExperiment(experimentClassName);
+      adv.loadAttribute( "experiment_", *experiment_ );
+    }
+    Indices pendingIndices;
+    Indices pendingReceived;
+    Sample pendingInput;
+    Sample pendingOutput;
+    adv.loadAttribute( "pendingIndices_", pendingIndices );
+    adv.loadAttribute( "pendingReceived_", pendingReceived );
+    adv.loadAttribute( "pendingInput_", pendingInput );
+    adv.loadAttribute( "pendingOutput_", pendingOutput );
+    for (UnsignedInteger k = 0; k < pendingIndices.getSize(); ++k)
+    {
+      const UnsignedInteger first = k * (inputDimension + 1);
+      const UnsignedInteger last = first + inputDimension + 1;
+      PendingTrajectory & trajectory = pending_[pendingIndices[k]];
+      if (experiment_.isNull())
+        trajectory.input_ = Sample(pendingInput, first, last);
+      trajectory.output_ = Sample(pendingOutput, first, last);
+      trajectory.received_ = Indices(pendingReceived.begin() + first, pendingReceived.begin() + last);
+      trajectory.receivedNumber_ = std::count(trajectory.received_.begin(), trajectory.received_.end(), 1);
+    }
+  }
 }
 
 
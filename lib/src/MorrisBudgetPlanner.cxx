@@ -0,0 +1,286 @@
+//                                               -*- C++ -*-
+/**
+ *  @brief MorrisBudgetPlanner
+ *
+ *  Copyright 2005-2018 Airbus-EDF-IMACS-Phimeca
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License.
+ *
+ *  This library is distributed in the hope that it will be useful
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+ *
+ */
+#include "otmorris/MorrisBudgetPlanner.hxx"
+#include "otmorris/MorrisExperimentGrid.hxx"
+#include <openturns/Exception.hxx>
+#include <openturns/Log.hxx>
+#include <openturns/RandomGenerator.hxx>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+using namespace OT;
+
+namespace OTMORRIS
+{
+
+CLASSNAMEINIT(MorrisBudgetPlanner)
+
+/* Default constructor */
+MorrisBudgetPlanner::MorrisBudgetPlanner()
+  : Object()
+  , inputDimension_(0)
+  , outputDimension_(0)
+  , stride_(0)
+  , fullDesignSize_(0)
+  , trajectoryMultiple_(1)
+  , interval_()
+  , evaluationCost_(0.0)
+  , workerNumber_(1)
+  , evaluationBudget_(0)
+  , timeBudget_(0.0)
+  , memoryBudget_(0)
+{
+  // Nothing to do
+}
+
+/* Constructor from the parameters of an experiment */
+MorrisBudgetPlanner::MorrisBudgetPlanner(const MorrisExperiment & experiment, const UnsignedInteger outputDimension)
+  : Object()
+  , inputDimension_(experiment.getBounds().getDimension())
+  , outputDimension_(outputDimension)
+  , stride_(experiment.getTrajectoryStride())
+  , fullDesignSize_(experiment.getFullDesignSize())
+  , trajectoryMultiple_(1)
+  , interval_(experiment.getBounds())
+  , evaluationCost_(0.0)
+  , workerNumber_(1)
+  , evaluationBudget_(0)
+  , timeBudget_(0.0)
+  , memoryBudget_(0)
+{
+  if (outputDimension == 0)
+    throw InvalidArgumentException(HERE) << "In MorrisBudgetPlanner, the output dimension should be positive";
+  // Antithetic trajectories come by pairs
+  const MorrisExperimentGrid * grid = dynamic_cast<const MorrisExperimentGrid *>(&experiment);
+  if (grid && grid->getAntithetic()) trajectoryMultiple_ = 2;
+}
+
+/* Number of distinct trajectories of the experiment */
+UnsignedInteger MorrisBudgetPlanner::getFullDesignSize() const
+{
+  return fullDesignSize_;
+}
+
+/* Cost of one evaluation of the model */
+Scalar MorrisBudgetPlanner::getEvaluationCost() const
+{
+  return evaluationCost_;
+}
+
+void MorrisBudgetPlanner::setEvaluationCost(const Scalar evaluationCost)
+{
+  if (!(evaluationCost >= 0.0))
+    throw InvalidArgumentException(HERE) << "In MorrisBudgetPlanner, the evaluation cost should be nonnegative, here cost=" << evaluationCost;
+  evaluationCost_ = evaluationCost;
+}
+
+/* Time pilotSize evaluations of the model */
+Scalar MorrisBudgetPlanner::measureEvaluationCost(const Function & model, const UnsignedInteger pilotSize)
+{
+  if (pilotSize == 0)
+    throw InvalidArgumentException(HERE) << "In MorrisBudgetPlanner::measureEvaluationCost, the pilot size should be positive";
+  if (model.getInputDimension() != inputDimension_)
+    throw InvalidDimensionException(HERE) << "In MorrisBudgetPlanner::measureEvaluationCost, expected a model of input dimension " << inputDimension_
+                                          << ", here dimension=" << model.getInputDimension();
+  if (model.getOutputDimension() != outputDimension_)
+    throw InvalidDimensionException(HERE) << "In MorrisBudgetPlanner::measureEvaluationCost, expected a model of output dimension " << outputDimension_
+                                          << ", here dimension=" << model.getOutputDimension();
+  // Uniform points of the domain, evaluated at once as Morris does
+  const Point lowerBound(interval_.getLowerBound());
+  const Point upperBound(interval_.getUpperBound());
+  const Point u(RandomGenerator::Generate(pilotSize * inputDimension_));
+  Sample pilot(pilotSize, inputDimension_);
+  for (UnsignedInteger i = 0; i < pilotSize; ++i)
+    for (UnsignedInteger j = 0; j < inputDimension_; ++j)
+      pilot(i, j) = lowerBound[j] + u[i * inputDimension_ + j] * (upperBound[j] - lowerBound[j]);
+  const std::chrono::steady_clock::time_point start(std::chrono::steady_clock::now());
+  (void) model(pilot);
+  const Scalar elapsed = std::chrono::duration<Scalar>(std::chrono::steady_clock::now() - start).count();
+  evaluationCost_ = elapsed / pilotSize;
+  LOGINFO(OSS() << "Measured " << evaluationCost_ << "s per evaluation over " << pilotSize << " evaluations");
+  return evaluationCost_;
+}
+
+/* Number of evaluations run in parallel */
+UnsignedInteger MorrisBudgetPlanner::getWorkerNumber() const
+{
+  return workerNumber_;
+}
+
+void MorrisBudgetPlanner::setWorkerNumber(const UnsignedInteger workerNumber)
+{
+  if (workerNumber == 0)
+    throw InvalidArgumentException(HERE) << "In MorrisBudgetPlanner, the number of workers should be positive";
+  workerNumber_ = workerNumber;
+}
+
+/* Budgets */
+UnsignedInteger MorrisBudgetPlanner::getEvaluationBudget() const
+{
+  return evaluationBudget_;
+}
+
+void MorrisBudgetPlanner::setEvaluationBudget(const UnsignedInteger evaluationBudget)
+{
+  evaluationBudget_ = evaluationBudget;
+}
+
+Scalar MorrisBudgetPlanner::getTimeBudget() const
+{
+  return timeBudget_;
+}
+
+void MorrisBudgetPlanner::setTimeBudget(const Scalar timeBudget)
+{
+  if (!(timeBudget >= 0.0))
+    throw InvalidArgumentException(HERE) << "In MorrisBudgetPlanner, the time budget should be nonnegative, here budget=" << timeBudget;
+  timeBudget_ = timeBudget;
+}
+
+UnsignedInteger MorrisBudgetPlanner::getMemoryBudget() const
+{
+  return memoryBudget_;
+}
+
+void MorrisBudgetPlanner::setMemoryBudget(const UnsignedInteger memoryBudget)
+{
+  memoryBudget_ = memoryBudget;
+}
+
+/* Number of evaluations of N trajectories */
+UnsignedInteger MorrisBudgetPlanner::computeEvaluationNumber(const UnsignedInteger N) const
+{
+  // Consecutive trajectories start stride points apart, the last one has d+1 points
+  if (N == 0) return 0;
+  return (N - 1) * stride_ + inputDimension_ + 1;
+}
+
+/* Wall time of N trajectories */
+Scalar MorrisBudgetPlanner::computeWallTime(const UnsignedInteger N) const
+{
+  const UnsignedInteger evaluationNumber = computeEvaluationNumber(N);
+  // Each worker runs its share of the evaluations one after the other
+  return std::ceil((1.0 * evaluationNumber) / workerNumber_) * evaluationCost_;
+}
+
+/* Memory of N trajectories */
+UnsignedInteger MorrisBudgetPlanner::computeDesignMemory(const UnsignedInteger N) const
+{
+  return computeEvaluationNumber(N) * inputDimension_ * sizeof(Scalar);
+}
+
+UnsignedInteger MorrisBudgetPlanner::computeOutputMemory(const UnsignedInteger N) const
+{
+  return computeEvaluationNumber(N) * outputDimension_ * sizeof(Scalar);
+}
+
+UnsignedInteger MorrisBudgetPlanner::computeEffectsMemory(const UnsignedInteger N) const
+{
+  // One effect per trajectory, input and output, as in Morris::getElementaryEffects
+  return N * inputDimension_ * outputDimension_ * sizeof(Scalar);
+}
+
+UnsignedInteger MorrisBudgetPlanner::computeMemory(const UnsignedInteger N) const
+{
+  return computeDesignMemory(N) + computeOutputMemory(N) + computeEffectsMemory(N);
+}
+
+/* Reject N trajectories if the experiment cannot generate them */
+void MorrisBudgetPlanner::checkTrajectoryNumber(const UnsignedInteger N) const
+{
+  if (N > fullDesignSize_)
+    throw InvalidArgumentException(HERE) << "You are requiring " << N << " trajectories whereas number of possibilites is " << fullDesignSize_;
+  if (N % trajectoryMultiple_ != 0)
+    throw InvalidArgumentException(HERE) << "In MorrisBudgetPlanner, the number of trajectories should be a multiple of " << trajectoryMultiple_ << ", here N=" << N;
+}
+
+/* Whether N trajectories fit the budgets */
+Bool MorrisBudgetPlanner::fitsBudgets(const UnsignedInteger N) const
+{
+  const Scalar evaluationNumber = (N == 0 ? 0.0 : (N - 1.0) * stride_ + inputDimension_ + 1.0);
+  if ((evaluationBudget_ > 0) && (evaluationNumber > evaluationBudget_)) return false;
+  if ((timeBudget_ > 0.0) && (std::ceil(evaluationNumber / workerNumber_) * evaluationCost_ > timeBudget_)) return false;
+  const Scalar memory = (evaluationNumber * (inputDimension_ + outputDimension_) + 1.0 * N * inputDimension_ * outputDimension_) * sizeof(Scalar);
+  if ((memoryBudget_ > 0) && (memory > memoryBudget_)) return false;
+  return true;
+}
+
+/* Whether N trajectories can be generated and fit the budgets */
+Bool MorrisBudgetPlanner::isFeasible(const UnsignedInteger N) const
+{
+  return (N <= fullDesignSize_) && (N % trajectoryMultiple_ == 0) && fitsBudgets(N);
+}
+
+/* Largest feasible number of trajectories */
+UnsignedInteger MorrisBudgetPlanner::computeLargestTrajectoryNumber() const
+{
+  const Bool noBudget = (evaluationBudget_ == 0) && (timeBudget_ == 0.0) && (memoryBudget_ == 0);
+  if (noBudget && (fullDesignSize_ == std::numeric_limits<UnsignedInteger>::max()))
+    throw InvalidArgumentException(HERE) << "In MorrisBudgetPlanner::computeLargestTrajectoryNumber, no budget is set and the design size is unlimited";
+  if ((timeBudget_ > 0.0) && (evaluationCost_ == 0.0))
+    throw InvalidArgumentException(HERE) << "In MorrisBudgetPlanner::computeLargestTrajectoryNumber, the evaluation cost should be set or measured to use a time budget";
+  // Each budget bounds the number of evaluations, hence the search range
+  Scalar maximumEvaluationNumber = std::numeric_limits<Scalar>::max();
+  if (evaluationBudget_ > 0)
+    maximumEvaluationNumber = std::min(maximumEvaluationNumber, 1.0 * evaluationBudget_);
+  if (timeBudget_ > 0.0)
+    maximumEvaluationNumber = std::min(maximumEvaluationNumber, timeBudget_ / evaluationCost_ * workerNumber_);
+  if (memoryBudget_ > 0)
+    maximumEvaluationNumber = std::min(maximumEvaluationNumber, memoryBudget_ / (1.0 * (inputDimension_ + outputDimension_) * sizeof(Scalar)));
+  UnsignedInteger upper = fullDesignSize_ / trajectoryMultiple_;
+  if (maximumEvaluationNumber / stride_ + 1.0 < upper)
+    upper = static_cast<UnsignedInteger>(maximumEvaluationNumber / stride_ + 1.0) / trajectoryMultiple_;
+  // Feasibility is monotone in N, bisect on the number of groups of trajectories
+  UnsignedInteger lower = 0;
+  while (lower < upper)
+  {
+    const UnsignedInteger middle = upper - (upper - lower) / 2;
+    if (fitsBudgets(middle * trajectoryMultiple_)) lower = middle;
+    else upper = middle - 1;
+  }
+  const UnsignedInteger N = lower * trajectoryMultiple_;
+  if (N < 2)
+    throw InvalidArgumentException(HERE) << "In MorrisBudgetPlanner::computeLargestTrajectoryNumber, the budgets do not allow two trajectories";
+  LOGINFO(OSS() << "Largest number of trajectories=" << N << ", evaluations=" << computeEvaluationNumber(N) << ", wall time=" << computeWallTime(N) << "s, memory=" << computeMemory(N) << " bytes");
+  return N;
+}
+
+/* String converter */
+String MorrisBudgetPlanner::__repr__() const
+{
+  OSS oss;
+  oss << "class=" << MorrisBudgetPlanner::GetClassName()
+      << ", input dimension=" << inputDimension_
+      << ", output dimension=" << outputDimension_
+      << ", stride=" << stride_
+      << ", full design size=" << fullDesignSize_
+      << ", evaluation cost=" << evaluationCost_
+      << ", workers=" << workerNumber_
+      << ", evaluation budget=" << evaluationBudget_
+      << ", time budget=" << timeBudget_
+      << ", memory budget=" << memoryBudget_;
+  return oss;
+}
+
+} /* namespace OTMORRIS */
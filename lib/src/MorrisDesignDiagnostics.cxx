@@ -0,0 +1,456 @@
+//                                               -*- C++ -*-
+/**
+ *  @brief MorrisDesignDiagnostics
+ *
+ *  Copyright 2005-2018 Airbus-EDF-IMACS-Phimeca
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License.
+ *
+ *  This library is distributed in the hope that it will be useful
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+ *
+ */
+#include "otmorris/MorrisDesignDiagnostics.hxx"
+#include <openturns/Exception.hxx>
+#include <openturns/Log.hxx>
+#include <openturns/SpecFunc.hxx>
+#include <openturns/TBBImplementation.hxx>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using namespace OT;
+
+namespace OTMORRIS
+{
+
+CLASSNAMEINIT(MorrisDesignDiagnostics)
+
+// Rows of a pairwise kernel sharing each streamed row while it is in cache
+static const UnsignedInteger KernelRowBlock = 8;
+
+/* Squared distance between two rows, with independent partial sums so that the loop vectorizes */
+static inline Scalar SquaredDistance(const Scalar * x, const Scalar * y, const UnsignedInteger dimension)
+{
+  Scalar s0 = 0.0;
+  Scalar s1 = 0.0;
+  Scalar s2 = 0.0;
+  Scalar s3 = 0.0;
+  UnsignedInteger k = 0;
+  for (; k + 4 <= dimension; k += 4)
+  {
+    const Scalar d0 = x[k] - y[k];
+    const Scalar d1 = x[k + 1] - y[k + 1];
+    const Scalar d2 = x[k + 2] - y[k + 2];
+    const Scalar d3 = x[k + 3] - y[k + 3];
+    s0 += d0 * d0;
+    s1 += d1 * d1;
+    s2 += d2 * d2;
+    s3 += d3 * d3;
+  }
+  for (; k < dimension; ++k)
+  {
+    const Scalar d0 = x[k] - y[k];
+    s0 += d0 * d0;
+  }
+  return (s0 + s1) + (s2 + s3);
+}
+
+/* Nearest neighbour and sum of the distances to the following rows, per row */
+struct TrajectoryDistancePolicy
+{
+  const std::vector<Scalar> & points_;
+  const UnsignedInteger size_;
+  const UnsignedInteger dimension_;
+  Point & nearest_;
+  Point & rowSum_;
+
+  TrajectoryDistancePolicy(const std::vector<Scalar> & points, const UnsignedInteger size, const UnsignedInteger dimension,
+                           Point & nearest, Point & rowSum)
+    : points_(points)
+    , size_(size)
+    , dimension_(dimension)
+    , nearest_(nearest)
+    , rowSum_(rowSum)
+  {}
+
+  inline void operator()(const TBBImplementation::BlockedRange<UnsignedInteger> & r) const
+  {
+    for (UnsignedInteger first = r.begin(); first < r.end(); first += KernelRowBlock)
+    {
+      const UnsignedInteger last = std::min(first + KernelRowBlock, r.end());
+      Scalar minimum[KernelRowBlock];
+      Scalar sum[KernelRowBlock];
+      std::fill(minimum, minimum + KernelRowBlock, SpecFunc::MaxScalar);
+      std::fill(sum, sum + KernelRowBlock, 0.0);
+      for (UnsignedInteger j = 0; j < size_; ++j)
+      {
+        const Scalar * y = &points_[j * dimension_];
+        for (UnsignedInteger i = first; i < last; ++i)
+        {
+          if (i == j) continue;
+          const Scalar distance = SquaredDistance(&points_[i * dimension_], y, dimension_);
+          minimum[i - first] = std::min(minimum[i - first], distance);
+          if (j > i) sum[i - first] += std::sqrt(distance);
+        }
+      }
+      for (UnsignedInteger i = first; i < last; ++i)
+      {
+        nearest_[i] = (size_ > 1 ? std::sqrt(minimum[i - first]) : 0.0);
+        rowSum_[i] = sum[i - first];
+      }
+    }
+  }
+}; /* end struct TrajectoryDistancePolicy */
+
+/* Pair factor of the centered L2 discrepancy, with independent partial products */
+static inline Scalar PairProduct(const Scalar * zi, const Scalar * ai, const Scalar * zj, const Scalar * aj, const UnsignedInteger dimension)
+{
+  Scalar p0 = 1.0;
+  Scalar p1 = 1.0;
+  Scalar p2 = 1.0;
+  Scalar p3 = 1.0;
+  UnsignedInteger k = 0;
+  for (; k + 4 <= dimension; k += 4)
+  {
+    p0 *= 1.0 + ai[k] + aj[k] - 0.5 * std::abs(zi[k] - zj[k]);
+    p1 *= 1.0 + ai[k + 1] + aj[k + 1] - 0.5 * std::abs(zi[k + 1] - zj[k + 1]);
+    p2 *= 1.0 + ai[k + 2] + aj[k + 2] - 0.5 * std::abs(zi[k + 2] - zj[k + 2]);
+    p3 *= 1.0 + ai[k + 3] + aj[k + 3] - 0.5 * std::abs(zi[k + 3] - zj[k + 3]);
+  }
+  for (; k < dimension; ++k)
+    p0 *= 1.0 + ai[k] + aj[k] - 0.5 * std::abs(zi[k] - zj[k]);
+  return (p0 * p1) * (p2 * p3);
+}
+
+/* Row sums of the pair term of the centered L2 discrepancy over j >= i, points centered on 1/2 */
+struct BaseDiscrepancyPolicy
+{
+  const std::vector<Scalar> & points_;
+  const std::vector<Scalar> & halfAbsolute_;
+  const UnsignedInteger size_;
+  const UnsignedInteger dimension_;
+  Point & rowSum_;
+
+  BaseDiscrepancyPolicy(const std::vector<Scalar> & points, const std::vector<Scalar> & halfAbsolute,
+                        const UnsignedInteger size, const UnsignedInteger dimension, Point & rowSum)
+    : points_(points)
+    , halfAbsolute_(halfAbsolute)
+    , size_(size)
+    , dimension_(dimension)
+    , rowSum_(rowSum)
+  {}
+
+  inline void operator()(const TBBImplementation::BlockedRange<UnsignedInteger> & r) const
+  {
+    for (UnsignedInteger first = r.begin(); first < r.end(); first += KernelRowBlock)
+    {
+      const UnsignedInteger last = std::min(first + KernelRowBlock, r.end());
+      Scalar sum[KernelRowBlock];
+      std::fill(sum, sum + KernelRowBlock, 0.0);
+      for (UnsignedInteger j = first; j < size_; ++j)
+      {
+        const Scalar * zj = &points_[j * dimension_];
+        const Scalar * aj = &halfAbsolute_[j * dimension_];
+        for (UnsignedInteger i = first; i < std::min(last, j + 1); ++i)
+        {
+          const Scalar product = PairProduct(&points_[i * dimension_], &halfAbsolute_[i * dimension_], zj, aj, dimension_);
+          sum[i - first] += (i == j ? product : 2.0 * product);
+        }
+      }
+      for (UnsignedInteger i = first; i < last; ++i)
+        rowSum_[i] = sum[i - first];
+    }
+  }
+}; /* end struct BaseDiscrepancyPolicy */
+
+/* Hash of each row, FNV-1a on the 64-bit words of the coordinates */
+struct RowHashPolicy
+{
+  const Scalar * data_;
+  const UnsignedInteger dimension_;
+  std::vector<std::pair<std::uint64_t, UnsignedInteger> > & hashes_;
+
+  RowHashPolicy(const Scalar * data, const UnsignedInteger dimension, std::vector<std::pair<std::uint64_t, UnsignedInteger> > & hashes)
+    : data_(data)
+    , dimension_(dimension)
+    , hashes_(hashes)
+  {}
+
+  inline void operator()(const TBBImplementation::BlockedRange<UnsignedInteger> & r) const
+  {
+    for (UnsignedInteger i = r.begin(); i != r.end(); ++i)
+    {
+      std::uint64_t hash = 14695981039346656037ULL;
+      for (UnsignedInteger k = 0; k < dimension_; ++k)
+      {
+        // -0.0 and 0.0 compare equal so they must hash the same
+        const Scalar value = data_[i * dimension_ + k] + 0.0;
+        std::uint64_t word = 0;
+        std::memcpy(&word, &value, sizeof(word));
+        hash ^= word;
+        hash *= 1099511628211ULL;
+      }
+      hashes_[i] = std::make_pair(hash, i);
+    }
+  }
+}; /* end struct RowHashPolicy */
+
+/* Lexicographic order on the rows of a row-major buffer */
+struct RowLess
+{
+  const Scalar * data_;
+  const UnsignedInteger dimension_;
+
+  RowLess(const Scalar * data, const UnsignedInteger dimension)
+    : data_(data)
+    , dimension_(dimension)
+  {}
+
+  inline bool operator()(const UnsignedInteger i, const UnsignedInteger j) const
+  {
+    return std::lexicographical_compare(data_ + i * dimension_, data_ + (i + 1) * dimension_,
+                                        data_ + j * dimension_, data_ + (j + 1) * dimension_);
+  }
+}; /* end struct RowLess */
+
+/* Default constructor */
+MorrisDesignDiagnostics::MorrisDesignDiagnostics()
+  : Object()
+  , levelNumber_(0)
+  , trajectoryNumber_(0)
+  , meanTrajectoryDistance_(0.0)
+  , nearestTrajectoryDistance_()
+  , levelHistogram_()
+  , baseDiscrepancy_(0.0)
+  , duplicateFraction_(0.0)
+{
+  // Nothing to do
+}
+
+/* Constructor from a design of N*(d+1) independent points or of a chain of N*d+1 points */
+MorrisDesignDiagnostics::MorrisDesignDiagnostics(const Sample & design, const Interval & interval, const UnsignedInteger levelNumber)
+  : Object()
+  , levelNumber_(levelNumber)
+  , trajectoryNumber_(0)
+  , meanTrajectoryDistance_(0.0)
+  , nearestTrajectoryDistance_()
+  , levelHistogram_()
+  , baseDiscrepancy_(0.0)
+  , duplicateFraction_(0.0)
+{
+  // Independent trajectories are preferred when the size matches both layouts
+  const UnsignedInteger dimension = design.getDimension();
+  const UnsignedInteger size = design.getSize();
+  UnsignedInteger stride = dimension + 1;
+  if ((size % stride != 0) && (dimension > 0) && (size > dimension) && ((size - 1) % dimension == 0))
+    stride = dimension;
+  run(design, interval, stride);
+}
+
+/* Constructor from a design generated by the experiment */
+MorrisDesignDiagnostics::MorrisDesignDiagnostics(const MorrisExperiment & experiment, const UnsignedInteger levelNumber)
+  : Object()
+  , levelNumber_(levelNumber)
+  , trajectoryNumber_(0)
+  , meanTrajectoryDistance_(0.0)
+  , nearestTrajectoryDistance_()
+  , levelHistogram_()
+  , baseDiscrepancy_(0.0)
+  , duplicateFraction_(0.0)
+{
+  run(experiment.generate(), experiment.getBounds(), experiment.getTrajectoryStride());
+}
+
+/* Compute all the diagnostics */
+void MorrisDesignDiagnostics::run(const Sample & design, const Interval & interval, const UnsignedInteger stride)
+{
+  const UnsignedInteger dimension = design.getDimension();
+  if (interval.getDimension() != dimension)
+    throw InvalidDimensionException(HERE) << "In MorrisDesignDiagnostics, the interval dimension=" << interval.getDimension()
+                                          << " does not match the design dimension=" << dimension;
+  if (levelNumber_ == 0)
+    throw InvalidArgumentException(HERE) << "In MorrisDesignDiagnostics, the number of levels should be positive";
+  // Trajectories of dimension+1 points start every stride points, stride being dimension for chains sharing one point
+  const UnsignedInteger trajectorySize = dimension + 1;
+  const UnsignedInteger size = design.getSize();
+  const UnsignedInteger N = (size < trajectorySize ? 0 : (size - trajectorySize) / stride + 1);
+  if ((N == 0) || (size != (N - 1) * stride + trajectorySize))
+    throw InvalidArgumentException(HERE) << "In MorrisDesignDiagnostics, the design size=" << size
+                                         << " does not match trajectories of " << trajectorySize << " points starting every " << stride << " points";
+  trajectoryNumber_ = N;
+
+  // Coordinates are read in place, scaled into the unit cube on the fly
+  const Point lowerBound(interval.getLowerBound());
+  const Point range(interval.getUpperBound() - lowerBound);
+  for (UnsignedInteger k = 0; k < dimension; ++k)
+    if (!(range[k] > 0.0))
+      throw InvalidArgumentException(HERE) << "In MorrisDesignDiagnostics, the interval should not be empty along axis " << k;
+  const Scalar * data = &design(0, 0);
+
+  // Level histograms, the upper bound falls into the last level
+  levelHistogram_ = Sample(dimension, levelNumber_);
+  for (UnsignedInteger i = 0; i < size; ++i)
+    for (UnsignedInteger k = 0; k < dimension; ++k)
+    {
+      const Scalar u = std::min(std::max((data[i * dimension + k] - lowerBound[k]) / range[k], 0.0), 1.0);
+      const UnsignedInteger level = std::min(static_cast<UnsignedInteger>(u * levelNumber_), levelNumber_ - 1);
+      levelHistogram_(k, level) += 1.0;
+    }
+
+  // Duplicated points: rows are only compared within runs of equal hashes
+  std::vector<std::pair<std::uint64_t, UnsignedInteger> > hashes(size);
+  const RowHashPolicy hashPolicy(data, dimension, hashes);
+  TBBImplementation::ParallelFor(0, size, hashPolicy);
+  std::sort(hashes.begin(), hashes.end());
+  std::vector<Bool> duplicated(size, false);
+  for (UnsignedInteger first = 0; first < size; )
+  {
+    UnsignedInteger last = first + 1;
+    while ((last < size) && (hashes[last].first == hashes[first].first)) ++ last;
+    if (last - first > 1)
+    {
+      // Equal rows are adjacent once the run is sorted
+      std::vector<UnsignedInteger> rows(last - first);
+      for (UnsignedInteger i = first; i < last; ++i) rows[i - first] = hashes[i].second;
+      std::sort(rows.begin(), rows.end(), RowLess(data, dimension));
+      for (UnsignedInteger i = 1; i < rows.size(); ++i)
+        if (std::equal(data + rows[i] * dimension, data + (rows[i] + 1) * dimension, data + rows[i - 1] * dimension))
+        {
+          duplicated[rows[i]] = true;
+          duplicated[rows[i - 1]] = true;
+        }
+    }
+    first = last;
+  }
+  duplicateFraction_ = (1.0 * std::count(duplicated.begin(), duplicated.end(), true)) / size;
+
+  // Centroids and centered base points of the trajectories
+  std::vector<Scalar> centroids(N * dimension, 0.0);
+  std::vector<Scalar> centered(N * dimension);
+  std::vector<Scalar> halfAbsolute(N * dimension);
+  for (UnsignedInteger n = 0; n < N; ++n)
+  {
+    for (UnsignedInteger i = 0; i < trajectorySize; ++i)
+      for (UnsignedInteger k = 0; k < dimension; ++k)
+        centroids[n * dimension + k] += data[(n * stride + i) * dimension + k];
+    for (UnsignedInteger k = 0; k < dimension; ++k)
+    {
+      centroids[n * dimension + k] = (centroids[n * dimension + k] / trajectorySize - lowerBound[k]) / range[k];
+      centered[n * dimension + k] = (data[n * stride * dimension + k] - lowerBound[k]) / range[k] - 0.5;
+      halfAbsolute[n * dimension + k] = 0.5 * std::abs(centered[n * dimension + k]);
+    }
+  }
+
+  // Inter-trajectory distances
+  nearestTrajectoryDistance_ = Point(N);
+  Point rowSum(N);
+  const TrajectoryDistancePolicy distancePolicy(centroids, N, dimension, nearestTrajectoryDistance_, rowSum);
+  TBBImplementation::ParallelFor(0, N, distancePolicy);
+  Scalar distanceSum = 0.0;
+  for (UnsignedInteger n = 0; n < N; ++n) distanceSum += rowSum[n];
+  meanTrajectoryDistance_ = (N > 1 ? 2.0 * distanceSum / (N * (N - 1.0)) : 0.0);
+
+  // Centered L2 discrepancy of the base points
+  const BaseDiscrepancyPolicy discrepancyPolicy(centered, halfAbsolute, N, dimension, rowSum);
+  TBBImplementation::ParallelFor(0, N, discrepancyPolicy);
+  Scalar pairSum = 0.0;
+  Scalar rowTerm = 0.0;
+  for (UnsignedInteger n = 0; n < N; ++n)
+  {
+    pairSum += rowSum[n];
+    Scalar product = 1.0;
+    for (UnsignedInteger k = 0; k < dimension; ++k)
+    {
+      const Scalar z = centered[n * dimension + k];
+      product *= 1.0 + 0.5 * std::abs(z) - 0.5 * z * z;
+    }
+    rowTerm += product;
+  }
+  const Scalar squaredDiscrepancy = std::pow(13.0 / 12.0, 1.0 * dimension) - 2.0 * rowTerm / N + pairSum / (1.0 * N * N);
+  baseDiscrepancy_ = std::sqrt(std::max(squaredDiscrepancy, 0.0));
+  LOGINFO(OSS() << "MorrisDesignDiagnostics: " << N << " trajectories, mean distance=" << meanTrajectoryDistance_
+          << ", base discrepancy=" << baseDiscrepancy_ << ", duplicates=" << duplicateFraction_);
+}
+
+/* Number of trajectories accessor */
+UnsignedInteger MorrisDesignDiagnostics::getTrajectoryNumber() const
+{
+  return trajectoryNumber_;
+}
+
+/* Distances between the centroids of the trajectories */
+Scalar MorrisDesignDiagnostics::getMinimumTrajectoryDistance() const
+{
+  if (nearestTrajectoryDistance_.getDimension() < 2) return 0.0;
+  return *std::min_element(nearestTrajectoryDistance_.begin(), nearestTrajectoryDistance_.end());
+}
+
+Scalar MorrisDesignDiagnostics::getMeanTrajectoryDistance() const
+{
+  return meanTrajectoryDistance_;
+}
+
+Point MorrisDesignDiagnostics::getNearestTrajectoryDistance() const
+{
+  return nearestTrajectoryDistance_;
+}
+
+/* Number of points per level, one row per input */
+Sample MorrisDesignDiagnostics::getLevelHistogram() const
+{
+  return levelHistogram_;
+}
+
+/* Fraction of the levels reached, per input */
+Point MorrisDesignDiagnostics::getLevelCoverage() const
+{
+  const UnsignedInteger dimension = levelHistogram_.getSize();
+  Point coverage(dimension);
+  for (UnsignedInteger k = 0; k < dimension; ++k)
+  {
+    for (UnsignedInteger l = 0; l < levelNumber_; ++l)
+      if (levelHistogram_(k, l) > 0.0) coverage[k] += 1.0;
+    coverage[k] /= levelNumber_;
+  }
+  return coverage;
+}
+
+/* Centered L2 discrepancy of the base points */
+Scalar MorrisDesignDiagnostics::getBaseDiscrepancy() const
+{
+  return baseDiscrepancy_;
+}
+
+/* Fraction of the points equal to another point of the design */
+Scalar MorrisDesignDiagnostics::getDuplicateFraction() const
+{
+  return duplicateFraction_;
+}
+
+/* String converter */
+String MorrisDesignDiagnostics::__repr__() const
+{
+  OSS oss;
+  oss << "class=" << MorrisDesignDiagnostics::GetClassName()
+      << ", trajectories=" << trajectoryNumber_
+      << ", minimum trajectory distance=" << getMinimumTrajectoryDistance()
+      << ", mean trajectory distance=" << meanTrajectoryDistance_
+      << ", level coverage=" << getLevelCoverage()
+      << ", base discrepancy=" << baseDiscrepancy_
+      << ", duplicate fraction=" << duplicateFraction_;
+  return oss;
+}
+
+} /* namespace OTMORRIS */
@@ -24,6 +24,10 @@
 #include <openturns/KPermutationsDistribution.hxx>
 #include <openturns/Exception.hxx>
 #include <openturns/Log.hxx>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <ostream>
 
 using namespace OT;
 
@@ -34,6 +38,9 @@ CLASSNAMEINIT(MorrisExperiment)
 
 static const Factory<MorrisExperiment> Factory_MorrisExperiment;
 
+// Version of the binary state, 2 adding the antithetic flag of MorrisExperimentGrid
+static const std::uint64_t BinaryVersion = 2;
+
 /** Default constructor */
 MorrisExperiment::MorrisExperiment()
   : WeightedExperimentImplementation(0)
@@ -80,12 +87,81 @@ Interval MorrisExperiment::getBounds() const
 }
 
 
+/* Number of trajectories accessors */
+UnsignedInteger MorrisExperiment::getTrajectoryNumber() const
+{
+  return N_;
+}
+
+void MorrisExperiment::setTrajectoryNumber(const UnsignedInteger N)
+{
+  N_ = N;
+  setSize(N * (delta_.getSize() + 1));
+}
+
+/* Number of points between the starts of two consecutive trajectories of generate() */
+UnsignedInteger MorrisExperiment::getTrajectoryStride() const
+{
+  // Trajectories are independent blocks of d+1 points
+  return delta_.getSize() + 1;
+}
+
+/* Number of distinct trajectories that can be generated */
+UnsignedInteger MorrisExperiment::getFullDesignSize() const
+{
+  // No limit unless the experiment has a finite set of trajectories
+  return std::numeric_limits<UnsignedInteger>::max();
+}
+
 /** Generate method */
 Sample MorrisExperiment::generate() const
 {
   throw NotYetImplementedException(HERE) << "in MorrisExperiment::generate";
 }
 
+/** Generate the trajectories of one shard of a reproducible design */
+Sample MorrisExperiment::generate(const UnsignedInteger, const UnsignedInteger, const UnsignedInteger) const
+{
+  throw NotYetImplementedException(HERE) << "in MorrisExperiment::generate";
+}
+
+/** Range of the trajectories of a shard */
+void MorrisExperiment::computeShardRange(const UnsignedInteger shardIndex, const UnsignedInteger shardCount,
+    UnsignedInteger & first, UnsignedInteger & last) const
+{
+  if (!(shardIndex < shardCount))
+    throw InvalidArgumentException(HERE) << "Shard index should be lesser than shard count. Here, shard index=" << shardIndex
+                                         << ", shard count=" << shardCount;
+  // Shards are contiguous blocks of trajectories with sizes differing by at most one
+  first = (shardIndex * N_) / shardCount;
+  last = ((shardIndex + 1) * N_) / shardCount;
+}
+
+/** Generate method writing the trajectories one by one into a file */
+void MorrisExperiment::generateToFile(const FileName &, const String &) const
+{
+  throw NotYetImplementedException(HERE) << "in MorrisExperiment::generateToFile";
+}
+
+/** Hash of a trajectory, used to filter replicates without storing them */
+UnsignedInteger MorrisExperiment::HashTrajectory(const Sample & trajectory)
+{
+  // FNV-1a on the bytes of the coordinates
+  UnsignedInteger hash = static_cast<UnsignedInteger>(14695981039346656037ULL);
+  for (UnsignedInteger i = 0; i < trajectory.getSize(); ++i)
+    for (UnsignedInteger j = 0; j < trajectory.getDimension(); ++j)
+    {
+      const Scalar value = trajectory(i, j);
+      const unsigned char * bytes = reinterpret_cast<const unsigned char *>(&value);
+      for (UnsignedInteger k = 0; k < sizeof(Scalar); ++k)
+      {
+        hash ^= bytes[k];
+        hash *= static_cast<UnsignedInteger>(1099511628211ULL);
+      }
+    }
+  return hash;
+}
+
 /* String converter */
 String MorrisExperiment::__repr__() const
 {
@@ -112,5 +188,55 @@ void MorrisExperiment::load(Advocate & adv)
   adv.loadAttribute( "N_", N_ );
 }
 
+/* Number of levels of the grid along an input, delta_ being 1 / (levels - 1) */
+UnsignedInteger MorrisExperiment::getLevelNumber(const UnsignedInteger k) const
+{
+  // Rounded, as 1 / delta_ may fall just below the integer number of steps
+  return static_cast<UnsignedInteger>(1.5 + 1.0 / delta_[k]);
+}
+
+/* Compact binary state of the parameters, used for pickling */
+void MorrisExperiment::saveBinary(std::ostream & stream) const
+{
+  const UnsignedInteger dimension = delta_.getSize();
+  const std::uint64_t header[3] = {BinaryVersion, static_cast<std::uint64_t>(dimension), static_cast<std::uint64_t>(N_)};
+  stream.write(reinterpret_cast<const char *>(header), sizeof(header));
+  const Point lowerBound(interval_.getLowerBound());
+  const Point upperBound(interval_.getUpperBound());
+  stream.write(reinterpret_cast<const char *>(&delta_[0]), dimension * sizeof(Scalar));
+  stream.write(reinterpret_cast<const char *>(&lowerBound[0]), dimension * sizeof(Scalar));
+  stream.write(reinterpret_cast<const char *>(&upperBound[0]), dimension * sizeof(Scalar));
+}
+
+void MorrisExperiment::loadBinary(std::istream & stream)
+{
+  loadBinaryState(stream);
+}
+
+/* Read the binary state of the parameters, returning the version it was saved with */
+UnsignedInteger MorrisExperiment::loadBinaryState(std::istream & stream)
+{
+  std::uint64_t header[3];
+  stream.read(reinterpret_cast<char *>(header), sizeof(header));
+  if (!stream)
+    throw FileNotFoundException(HERE) << "In MorrisExperiment::loadBinary, truncated state";
+  if (header[0] > BinaryVersion)
+    throw NotYetImplementedException(HERE) << "In MorrisExperiment::loadBinary, got version " << header[0]
+                                           << ", only versions up to " << BinaryVersion << " are supported";
+  const UnsignedInteger dimension = header[1];
+  Point lowerBound(dimension);
+  Point upperBound(dimension);
+  delta_ = Point(dimension);
+  stream.read(reinterpret_cast<char *>(&delta_[0]), dimension * sizeof(Scalar));
+  stream.read(reinterpret_cast<char *>(&lowerBound[0]), dimension * sizeof(Scalar));
+  stream.read(reinterpret_cast<char *>(&upperBound[0]), dimension * sizeof(Scalar));
+  if (!stream)
+    throw FileNotFoundException(HERE) << "In MorrisExperiment::loadBinary, truncated state";
+  interval_ = Interval(lowerBound, upperBound);
+  // The state was valid when saved, so derived classes checks are not needed
+  MorrisExperiment::setTrajectoryNumber(header[2]);
+  return header[0];
+}
+
 
 } /* namespace OTMORRIS */
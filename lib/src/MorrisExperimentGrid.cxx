@@ -26,6 +26,13 @@
 #include <openturns/UserDefined.hxx>
 #include <openturns/RandomGenerator.hxx>
 #include <openturns/Log.hxx>
+#include "otmorris/TrajectoryFile.hxx"
+#include "otmorris/RandomStream.hxx"
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <set>
 
 using namespace OT;
 
@@ -37,10 +44,20 @@ CLASSNAMEINIT(MorrisExperimentGrid)
 static const Factory<MorrisExperimentGrid> Factory_MorrisExperimentGrid;
 
 
+// Whether an antithetic pair shares no trajectory with the pairs already drawn, whose hashes are then updated
+static Bool AcceptPair(const UnsignedInteger hash, const UnsignedInteger mirrorHash, std::set<UnsignedInteger> & hashes)
+{
+  if ((hash == mirrorHash) || hashes.count(hash) || hashes.count(mirrorHash)) return false;
+  hashes.insert(hash);
+  hashes.insert(mirrorHash);
+  return true;
+}
+
 /** Constructor using a p-level grid  - Uniform(0,1)^d */
 MorrisExperimentGrid::MorrisExperimentGrid(const Indices & levels, const UnsignedInteger N)
   : MorrisExperiment(Point(levels.getSize()), Interval(levels.getSize()), N)
   , jumpStep_(levels.getSize(), 0)
+  , antithetic_(false)
 {
   // Compute step
   for (UnsignedInteger k = 0; k < levels.getSize(); ++k)
@@ -57,6 +74,7 @@ MorrisExperimentGrid::MorrisExperimentGrid(const Indices & levels, const Unsigne
 MorrisExperimentGrid::MorrisExperimentGrid(const Indices & levels, const Interval & interval, const UnsignedInteger N)
   : MorrisExperiment(Point(levels.getSize()), interval, N)
   , jumpStep_(levels.getSize(), 0)
+  , antithetic_(false)
 {
   if (levels.getSize() != interval.getDimension())
     throw InvalidArgumentException(HERE) << "Levels and interval should be of same size. Here, level's size=" << levels.getSize()
@@ -83,28 +101,139 @@ MorrisExperimentGrid * MorrisExperimentGrid::clone() const
 Sample MorrisExperimentGrid::generate() const
 {
   const UnsignedInteger dimension = delta_.getDimension();
+  // Replicates are filtered by hash in drawing order, exactly as in generateToFile
+  std::set<UnsignedInteger> hashes;
   Sample realizations(0, dimension);
-  for (UnsignedInteger k = 0; k < N_; ++k)
-    realizations.add(generateTrajectory());
-  // Filter replicate trajectories
-  Sample uniqueTrajectories(N_, dimension * (dimension + 1));
-  uniqueTrajectories.getImplementation()->setData(realizations.getImplementation()->getData());
-  // Sort and keep unique data
-  uniqueTrajectories = uniqueTrajectories.sortUnique();
+  if (antithetic_)
+  {
+    // Pairs are kept in generation order
+    while (realizations.getSize() < N_ * (dimension + 1))
+    {
+      const Sample trajectory(generateTrajectory());
+      const Sample mirror(mirrorTrajectory(trajectory));
+      if (!AcceptPair(HashTrajectory(trajectory), HashTrajectory(mirror), hashes)) continue;
+      realizations.add(trajectory);
+      realizations.add(mirror);
+    }
+    return realizations;
+  }
+  Sample uniqueTrajectories(0, dimension * (dimension + 1));
   while (uniqueTrajectories.getSize() < N_)
   {
-    // Add a trajectory
-    Sample newTrajectory(generateTrajectory());
-    uniqueTrajectories.add(newTrajectory.getImplementation()->getData());
-    // Sort and keep unique data
-    uniqueTrajectories = uniqueTrajectories.sortUnique();
+    const Sample trajectory(generateTrajectory());
+    if (hashes.insert(HashTrajectory(trajectory)).second)
+      uniqueTrajectories.add(trajectory.getImplementation()->getData());
   }
-  // return sample
+  // Trajectories are sorted, the file holding the same ones in drawing order
+  uniqueTrajectories = uniqueTrajectories.sortUnique();
   realizations = Sample(uniqueTrajectories.getSize() * (dimension + 1), dimension);
   realizations.getImplementation()->setData(uniqueTrajectories.getImplementation()->getData());
   return realizations;
 }
 
+/** Generate method writing the trajectories one by one into a file */
+void MorrisExperimentGrid::generateToFile(const FileName & fileName, const String & format) const
+{
+  const UnsignedInteger dimension = delta_.getDimension();
+  TrajectoryFile file(fileName, dimension, format);
+  // Only hashes are kept to filter replicate trajectories, with the same draws as generate()
+  std::set<UnsignedInteger> hashes;
+  while (file.getTrajectoryNumber() < N_)
+  {
+    const Sample trajectory(generateTrajectory());
+    if (!antithetic_)
+    {
+      if (hashes.insert(HashTrajectory(trajectory)).second)
+        file.add(trajectory);
+      continue;
+    }
+    const Sample mirror(mirrorTrajectory(trajectory));
+    if (!AcceptPair(HashTrajectory(trajectory), HashTrajectory(mirror), hashes)) continue;
+    file.add(trajectory);
+    file.add(mirror);
+  }
+  file.close();
+}
+
+/** Generate the trajectories of one shard of a reproducible design */
+Sample MorrisExperimentGrid::generate(const UnsignedInteger shardIndex, const UnsignedInteger shardCount, const UnsignedInteger seed) const
+{
+  UnsignedInteger first = 0;
+  UnsignedInteger last = 0;
+  computeShardRange(shardIndex, shardCount, first, last);
+  const UnsignedInteger dimension = delta_.getDimension();
+  // Number of admissible levels of each coordinate of the starting points
+  Indices radix(dimension);
+  for (UnsignedInteger p = 0; p < dimension; ++p)
+    radix[p] = getLevelNumber(p) - jumpStep_[p];
+  // The primal trajectories of antithetic pairs start in the lower half of the levels of the first axis,
+  // strictly below the center, and their mirrors in the upper half: a mirror is never a primal trajectory
+  if (antithetic_)
+    radix[0] = std::min(radix[0], getLevelNumber(0) / 2);
+  // Trajectory k starts from the point coded by a keyed bijection of k, so that
+  // trajectories never share their starting point whatever the shard they belong to.
+  // Only the first axes are coded when the grid is too large, the others are random.
+  const UnsignedInteger maximumCodeSize = static_cast<UnsignedInteger>(1) << 62;
+  UnsignedInteger codeSize = 1;
+  UnsignedInteger codedAxes = 0;
+  while ((codedAxes < dimension) && (codeSize <= maximumCodeSize / radix[codedAxes]))
+  {
+    codeSize *= radix[codedAxes];
+    ++ codedAxes;
+  }
+  // Beyond codeSize trajectories, a starting point is reused with a rotated
+  // axes order, which changes the first moved axis
+  const UnsignedInteger primalNumber = (antithetic_ ? N_ / 2 : N_);
+  const UnsignedInteger rounds = (primalNumber + codeSize - 1) / codeSize;
+  if (rounds > dimension)
+    throw InvalidArgumentException(HERE) << "Cannot generate " << N_ << " distinct reproducible trajectories from " << codeSize << " starting points";
+
+  // Trajectory 2m + 1 of an antithetic design is the mirror of trajectory 2m, built from primal m
+  Sample realizations(0, dimension);
+  for (UnsignedInteger k = first; k < last; ++k)
+  {
+    if (!antithetic_)
+    {
+      realizations.add(generateCodedTrajectory(k, radix, codeSize, codedAxes, seed));
+      continue;
+    }
+    const Sample trajectory(generateCodedTrajectory(k / 2, radix, codeSize, codedAxes, seed));
+    realizations.add(k % 2 == 0 ? trajectory : mirrorTrajectory(trajectory));
+  }
+  return realizations;
+}
+
+/* Trajectory of a reproducible design from the index of its starting point code */
+Sample MorrisExperimentGrid::generateCodedTrajectory(const UnsignedInteger index, const Indices & radix, const UnsignedInteger codeSize,
+    const UnsignedInteger codedAxes, const UnsignedInteger seed) const
+{
+  const UnsignedInteger dimension = delta_.getDimension();
+  const UnsignedInteger slot = index % codeSize;
+  const UnsignedInteger rotation = index / codeSize;
+  UnsignedInteger code = RandomStream::Permute(slot, codeSize, seed);
+  // Trajectories sharing a starting point also share their random stream
+  RandomStream stream(seed, slot);
+  Point xBase(dimension);
+  for (UnsignedInteger p = 0; p < dimension; ++p)
+  {
+    UnsignedInteger digit = 0;
+    if (p < codedAxes)
+    {
+      digit = code % radix[p];
+      code /= radix[p];
+    }
+    else
+      digit = stream.integerGenerate(radix[p]);
+    xBase[p] = delta_[p] * digit;
+  }
+  const Indices permutation(stream.permutation(dimension));
+  Indices rotatedPermutation(dimension);
+  for (UnsignedInteger i = 0; i < dimension; ++i) rotatedPermutation[i] = permutation[(i + rotation) % dimension];
+  Point directions(dimension);
+  for (UnsignedInteger p = 0; p < dimension; ++p) directions[p] = (stream.integerGenerate(2) == 0 ? -1.0 : 1.0);
+  return buildTrajectory(xBase, rotatedPermutation, directions);
+}
+
 Sample MorrisExperimentGrid::generateTrajectory() const
 {
   const UnsignedInteger dimension = delta_.getDimension();
@@ -115,21 +244,12 @@ Sample MorrisExperimentGrid::generateTrajectory() const
   admissibleDirections(0, 0) =  -1.0;
   admissibleDirections(1, 0) = 1.0;
   const UserDefined directionDistribution(admissibleDirections);
-  // Interval parameters
-  const Point lowerBound(interval_.getLowerBound());
-  const Point upperBound(interval_.getUpperBound());
-  const Point deltaBounds(upperBound - lowerBound);
-  // Support sample for path
-  Sample path(dimension + 1, dimension);
-  Point delta(delta_);
-  // Scaling delta
-  for(UnsignedInteger k = 0; k < dimension; ++k) delta[k] *= jumpStep_[k];
 
   // First generate points from regular grid U(0,1)^d
   Point xBase(dimension, 0.0);
   for (UnsignedInteger p = 0; p < dimension; ++p)
   {
-    const UnsignedInteger level = static_cast<UnsignedInteger>(1.0 + 1.0 / delta_[p]);
+    const UnsignedInteger level = getLevelNumber(p);
     xBase[p] = delta_[p] * RandomGenerator::IntegerGenerate(level - jumpStep_[p]);
   }
   Log::Info(OSS() << "Generated point = " << xBase);
@@ -141,6 +261,24 @@ Sample MorrisExperimentGrid::generateTrajectory() const
   const Point directions(directionDistribution.getSample(dimension).getImplementation()->getData());
   Log::Debug(OSS() << "directions = " << directions);
 
+  Indices permutation(dimension);
+  for (UnsignedInteger i = 0; i < dimension; ++i) permutation[i] = static_cast<UnsignedInteger>(permutations[i]);
+  return buildTrajectory(xBase, permutation, directions);
+}
+
+Sample MorrisExperimentGrid::buildTrajectory(Point xBase, const Indices & permutation, const Point & directions) const
+{
+  const UnsignedInteger dimension = delta_.getDimension();
+  // Interval parameters
+  const Point lowerBound(interval_.getLowerBound());
+  const Point upperBound(interval_.getUpperBound());
+  const Point deltaBounds(upperBound - lowerBound);
+  // Support sample for path
+  Sample path(dimension + 1, dimension);
+  Point delta(delta_);
+  // Scaling delta
+  for(UnsignedInteger k = 0; k < dimension; ++k) delta[k] *= jumpStep_[k];
+
   // We start by setting the initial point
   for (UnsignedInteger i = 0; i < dimension; ++i)
     path(0, i) = deltaBounds[i] * xBase[i] + lowerBound[i];
@@ -149,7 +287,7 @@ Sample MorrisExperimentGrid::generateTrajectory() const
   // on which we update coordinate (and select also the direction)
   for (UnsignedInteger i = 0; i < dimension; ++i)
   {
-    const UnsignedInteger p = static_cast<UnsignedInteger>(permutations[i]);
+    const UnsignedInteger p = permutation[i];
     Scalar value = directions[p] * delta[p];
 
     // Check that direction is feasible
@@ -165,6 +303,36 @@ Sample MorrisExperimentGrid::generateTrajectory() const
   return path;
 }
 
+/* Mirror of a trajectory through the center of the domain */
+Sample MorrisExperimentGrid::mirrorTrajectory(const Sample & trajectory) const
+{
+  // The grid is symmetric, so the mirrored base point is on the grid and each move is reversed
+  const Point center(interval_.getLowerBound() + interval_.getUpperBound());
+  Sample mirror(trajectory.getSize(), trajectory.getDimension());
+  for (UnsignedInteger i = 0; i < trajectory.getSize(); ++i)
+    for (UnsignedInteger j = 0; j < trajectory.getDimension(); ++j)
+      mirror(i, j) = center[j] - trajectory(i, j);
+  return mirror;
+}
+
+/* Number of trajectories accessor, checked against the full design size */
+void MorrisExperimentGrid::setTrajectoryNumber(const UnsignedInteger N)
+{
+  if (antithetic_ && (N % 2 != 0))
+    throw InvalidArgumentException(HERE) << "With antithetic pairs, the number of trajectories should be even, here N=" << N;
+  const UnsignedInteger previousN = N_;
+  MorrisExperiment::setTrajectoryNumber(N);
+  try
+  {
+    setJumpStep(jumpStep_);
+  }
+  catch (const InvalidArgumentException &)
+  {
+    MorrisExperiment::setTrajectoryNumber(previousN);
+    throw;
+  }
+}
+
 /** get/set jumpStep */
 Indices MorrisExperimentGrid::getJumpStep() const
 {
@@ -179,14 +347,11 @@ void MorrisExperimentGrid::setJumpStep(const Indices & jumpStep)
                                          << ", got element of size=" << jumpStep.getSize();
 
   // Update the jump step and check that we still might generate N_ trajectories
-  // Compute step & number of total possibilities
-  // Depending on direction
-  UnsignedInteger fullDesignSize = 2;
   for (UnsignedInteger k = 0; k < jumpStep.getSize(); ++k)
   {
     const UnsignedInteger one = 1;
     const UnsignedInteger jumpStepK = static_cast<UnsignedInteger>(std::floor(jumpStep[k]));
-    const UnsignedInteger level = static_cast<UnsignedInteger>(1.0 + 1.0 / delta_[k]);
+    const UnsignedInteger level = getLevelNumber(k);
     // Check on jumpStep value
     // level - jS should be at least one, so
     // 1/delta +1 - jS >= 1, which equals 1/delta >= jS
@@ -195,17 +360,44 @@ void MorrisExperimentGrid::setJumpStep(const Indices & jumpStep)
     jumpStep_[k] = std::max(one, jumpStepK);
     if (jumpStep[k] != jumpStep_[k])
       LOGWARN(OSS() << "Element " << k << " changed. Value set = " << jumpStep_[k]);
-
-    // Update full design size
-    fullDesignSize *= (level - jumpStep_[k]);
   }
 
   // Check that with N <= full design size
   // otherwise we update N
+  const UnsignedInteger fullDesignSize = getFullDesignSize();
   if (!(N_ <= fullDesignSize))
     throw InvalidArgumentException (HERE) << "You are requiring " << N_ << " trajectories whereas number of possibilites is " << fullDesignSize;
 }
 
+/* Number of distinct trajectories that can be generated */
+UnsignedInteger MorrisExperimentGrid::getFullDesignSize() const
+{
+  // Admissible starting points of the grid, times both directions, saturated on overflow
+  const UnsignedInteger maximumSize = std::numeric_limits<UnsignedInteger>::max();
+  UnsignedInteger fullDesignSize = 2;
+  for (UnsignedInteger k = 0; k < jumpStep_.getSize(); ++k)
+  {
+    const UnsignedInteger level = getLevelNumber(k);
+    const UnsignedInteger admissible = level - jumpStep_[k];
+    if (fullDesignSize > maximumSize / admissible) return maximumSize;
+    fullDesignSize *= admissible;
+  }
+  return fullDesignSize;
+}
+
+/** Antithetic pairs accessors */
+Bool MorrisExperimentGrid::getAntithetic() const
+{
+  return antithetic_;
+}
+
+void MorrisExperimentGrid::setAntithetic(const Bool antithetic)
+{
+  if (antithetic && (N_ % 2 != 0))
+    throw InvalidArgumentException(HERE) << "With antithetic pairs, the number of trajectories should be even, here N=" << N_;
+  antithetic_ = antithetic;
+}
+
 /* String converter */
 String MorrisExperimentGrid::__repr__() const
 {
@@ -219,6 +411,7 @@ void MorrisExperimentGrid::save(Advocate & adv) const
 {
   MorrisExperiment::save( adv );
   adv.saveAttribute( "jumpStep_", jumpStep_ );
+  adv.saveAttribute( "antithetic_", antithetic_ );
 }
 
 /* Method load() reloads the object from the StorageManager */
@@ -226,6 +419,46 @@ void MorrisExperimentGrid::load(Advocate & adv)
 {
   MorrisExperiment::load( adv );
   adv.loadAttribute( "jumpStep_", jumpStep_ );
+  antithetic_ = false;
+  if (adv.hasAttribute( "antithetic_" ))
+    adv.loadAttribute( "antithetic_", antithetic_ );
+}
+
+/* Compact binary state of the parameters, used for pickling */
+void MorrisExperimentGrid::saveBinary(std::ostream & stream) const
+{
+  MorrisExperiment::saveBinary(stream);
+  for (UnsignedInteger k = 0; k < jumpStep_.getSize(); ++k)
+  {
+    const std::uint64_t jumpStep = jumpStep_[k];
+    stream.write(reinterpret_cast<const char *>(&jumpStep), sizeof(jumpStep));
+  }
+  const std::uint64_t antithetic = antithetic_;
+  stream.write(reinterpret_cast<const char *>(&antithetic), sizeof(antithetic));
+}
+
+void MorrisExperimentGrid::loadBinary(std::istream & stream)
+{
+  const UnsignedInteger version = loadBinaryState(stream);
+  jumpStep_ = Indices(delta_.getSize());
+  for (UnsignedInteger k = 0; k < jumpStep_.getSize(); ++k)
+  {
+    std::uint64_t jumpStep = 0;
+    stream.read(reinterpret_cast<char *>(&jumpStep), sizeof(jumpStep));
+    jumpStep_[k] = jumpStep;
+  }
+  if (!stream)
+    throw FileNotFoundException(HERE) << "In MorrisExperimentGrid::loadBinary, truncated state";
+  // Antithetic pairs, since version 2
+  antithetic_ = false;
+  if (version >= 2)
+  {
+    std::uint64_t antithetic = 0;
+    stream.read(reinterpret_cast<char *>(&antithetic), sizeof(antithetic));
+    if (!stream)
+      throw FileNotFoundException(HERE) << "In MorrisExperimentGrid::loadBinary, truncated state";
+    antithetic_ = (antithetic != 0);
+  }
 }
 
 
@@ -25,6 +25,13 @@
 #include <openturns/UserDefined.hxx>
 #include <openturns/RandomGenerator.hxx>
 #include <openturns/Log.hxx>
+#include "otmorris/TrajectoryFile.hxx"
+#include "otmorris/RandomStream.hxx"
+#include "otmorris/SpaceFillingLHS.hxx"
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <set>
 
 using namespace OT;
 
@@ -56,31 +63,52 @@ MorrisExperimentLHS::MorrisExperimentLHS(const Sample & lhsDesign, const Interva
                                          << ", interval's size=" << interval_.getDimension();
 }
 
+/** Constructor building a space-filling LHS design of the given size */
+MorrisExperimentLHS::MorrisExperimentLHS(const UnsignedInteger size, const Interval & interval, const UnsignedInteger N, const String & criterion)
+  : MorrisExperimentLHS(BuildSpaceFillingDesign(size, interval, criterion), interval, N)
+{
+  // Nothing to do
+}
+
+/** Optimized centered LHS design of the interval */
+Sample MorrisExperimentLHS::BuildSpaceFillingDesign(const UnsignedInteger size, const Interval & interval, const String & criterion)
+{
+  const UnsignedInteger dimension = interval.getDimension();
+  // The optimizer has its own random streams, seeded from the shared generator
+  const UnsignedInteger seed = RandomGenerator::IntegerGenerate(1, 2147483647)[0];
+  const Sample unitDesign(SpaceFillingLHS(size, dimension, criterion).generate(seed));
+  const Point lowerBound(interval.getLowerBound());
+  const Point upperBound(interval.getUpperBound());
+  Sample design(size, dimension);
+  for (UnsignedInteger i = 0; i < size; ++i)
+    for (UnsignedInteger k = 0; k < dimension; ++k)
+      design(i, k) = lowerBound[k] + unitDesign(i, k) * (upperBound[k] - lowerBound[k]);
+  return design;
+}
+
 /* Virtual constructor method */
 MorrisExperimentLHS * MorrisExperimentLHS::clone() const
 {
   return new MorrisExperimentLHS(*this);
 }
 
-/** Generate method */
-Sample MorrisExperimentLHS::generate() const
+/* Number of distinct trajectories that can be generated */
+UnsignedInteger MorrisExperimentLHS::getFullDesignSize() const
+{
+  // Each starting point is used with each first moved axis, as in the sharded generation
+  return experiment_.getSize() * delta_.getDimension();
+}
+
+/** Draw the indices of the starting points in the LHS design */
+Indices MorrisExperimentLHS::drawStartingIndices() const
 {
-  // Support sample for realizations
-  const UnsignedInteger dimension(delta_.getDimension());
-  Sample realizations(0, dimension);
-  // First generate all indices
   const UnsignedInteger size(experiment_.getSize());
+  Indices indices(N_);
   if (N_ <= size)
   {
     Log::Info("Number of trajectories lesser than LHS size : generate fully independent paths");
-    const Point indices(KPermutationsDistribution(N_, size).getRealization());
-    for (UnsignedInteger k = 0; k < N_; ++k)
-    {
-      UnsignedInteger index(static_cast<UnsignedInteger>(indices[k]));
-      Log::Debug(OSS() << "Trajectory " << k << ", index = " << index);
-      realizations.add(generateTrajectory(index));
-    }
-    return realizations;
+    const Point drawWithoutReplacement(KPermutationsDistribution(N_, size).getRealization());
+    for (UnsignedInteger k = 0; k < N_; ++k) indices[k] = static_cast<UnsignedInteger>(drawWithoutReplacement[k]);
   }
   else
   {
@@ -88,15 +116,31 @@ Sample MorrisExperimentLHS::generate() const
     // Instead of using full draw with replacement,
     // we select all points + N_ - size other points with replacement
     Log::Info("Number of trajectories is greater than LHS size : some path could start from the same point");
-    Collection<UnsignedInteger> indices(RandomGenerator::IntegerGenerate(N_ - size, size));
+    const RandomGenerator::UnsignedIntegerCollection replicates(RandomGenerator::IntegerGenerate(N_ - size, size));
+    indices = Indices(replicates.begin(), replicates.end());
     const Point drawWithoutReplacement(KPermutationsDistribution(size, size).getRealization());
     for (UnsignedInteger k = 0; k < size; ++k) indices.add(static_cast<UnsignedInteger>(drawWithoutReplacement[k]));
-    for (UnsignedInteger k = 0; k < N_; ++k)
-    {
-      Log::Debug(OSS() << "Trajectory " << k << ", index = " << indices[k]);
-      realizations.add(generateTrajectory(indices[k]));
-    }
   }
+  return indices;
+}
+
+/** Generate method */
+Sample MorrisExperimentLHS::generate() const
+{
+  // Support sample for realizations
+  const UnsignedInteger dimension(delta_.getDimension());
+  Sample realizations(0, dimension);
+  // First generate all indices
+  const UnsignedInteger size(experiment_.getSize());
+  const Indices indices(drawStartingIndices());
+  for (UnsignedInteger k = 0; k < N_; ++k)
+  {
+    Log::Debug(OSS() << "Trajectory " << k << ", index = " << indices[k]);
+    realizations.add(generateTrajectory(indices[k]));
+  }
+  // Distinct starting points give distinct trajectories
+  if (N_ <= size)
+    return realizations;
   // Filter replicate trajectories
   Sample uniqueTrajectories(N_, dimension * (dimension + 1));
   uniqueTrajectories.getImplementation()->setData(realizations.getImplementation()->getData());
@@ -120,6 +164,63 @@ Sample MorrisExperimentLHS::generate() const
   return realizations;
 }
 
+/** Generate method writing the trajectories one by one into a file */
+void MorrisExperimentLHS::generateToFile(const FileName & fileName, const String & format) const
+{
+  const UnsignedInteger dimension(delta_.getDimension());
+  const UnsignedInteger size(experiment_.getSize());
+  TrajectoryFile file(fileName, dimension, format);
+  // Only hashes are kept to filter replicate trajectories
+  std::set<UnsignedInteger> hashes;
+  const Indices indices(drawStartingIndices());
+  for (UnsignedInteger k = 0; k < N_; ++k)
+  {
+    const Sample trajectory(generateTrajectory(indices[k]));
+    if (hashes.insert(HashTrajectory(trajectory)).second)
+      file.add(trajectory);
+  }
+  while (file.getTrajectoryNumber() < N_)
+  {
+    const Sample trajectory(generateTrajectory(RandomGenerator::IntegerGenerate(size)));
+    if (hashes.insert(HashTrajectory(trajectory)).second)
+      file.add(trajectory);
+  }
+  file.close();
+}
+
+/** Generate the trajectories of one shard of a reproducible design */
+Sample MorrisExperimentLHS::generate(const UnsignedInteger shardIndex, const UnsignedInteger shardCount, const UnsignedInteger seed) const
+{
+  UnsignedInteger first = 0;
+  UnsignedInteger last = 0;
+  computeShardRange(shardIndex, shardCount, first, last);
+  const UnsignedInteger dimension(delta_.getDimension());
+  const UnsignedInteger size(experiment_.getSize());
+  // Trajectory k starts from the LHS point given by a keyed bijection of k, so that
+  // trajectories never share their starting point whatever the shard they belong to.
+  // Beyond size trajectories, a starting point is reused with a rotated
+  // axes order, which changes the first moved axis
+  const UnsignedInteger rounds = (N_ + size - 1) / size;
+  if (rounds > dimension)
+    throw InvalidArgumentException(HERE) << "Cannot generate " << N_ << " distinct reproducible trajectories from an LHS design of size " << size;
+
+  Sample realizations(0, dimension);
+  for (UnsignedInteger k = first; k < last; ++k)
+  {
+    const UnsignedInteger slot = k % size;
+    const UnsignedInteger rotation = k / size;
+    // Trajectories sharing a starting point also share their random stream
+    RandomStream stream(seed, slot);
+    const Indices permutation(stream.permutation(dimension));
+    Indices rotatedPermutation(dimension);
+    for (UnsignedInteger i = 0; i < dimension; ++i) rotatedPermutation[i] = permutation[(i + rotation) % dimension];
+    Point directions(dimension);
+    for (UnsignedInteger i = 0; i < dimension; ++i) directions[i] = (stream.integerGenerate(2) == 0 ? 1.0 : -1.0);
+    realizations.add(buildTrajectory(RandomStream::Permute(slot, size, seed), rotatedPermutation, directions));
+  }
+  return realizations;
+}
+
 /** Generate 1 trajectory */
 Sample MorrisExperimentLHS::generateTrajectory(const UnsignedInteger index) const
 {
@@ -133,6 +234,17 @@ Sample MorrisExperimentLHS::generateTrajectory(const UnsignedInteger index) cons
   admissibleDirections(0, 0) = 1.0;
   admissibleDirections(1, 0) = -1.0;
   const UserDefined directionDistribution(admissibleDirections);
+  // Define the direction +/-
+  const Point directions(directionDistribution.getSample(dimension).getImplementation()->getData());
+  Indices permutation(dimension);
+  for (UnsignedInteger i = 0; i < dimension; ++i) permutation[i] = static_cast<UnsignedInteger>(permutations[i]);
+  return buildTrajectory(index, permutation, directions);
+}
+
+/** Build the trajectory from its starting point index, axes order and directions */
+Sample MorrisExperimentLHS::buildTrajectory(const UnsignedInteger index, const Indices & permutation, const Point & directions) const
+{
+  const UnsignedInteger dimension(delta_.getDimension());
   // Interval parameters
   const Point lowerBound(interval_.getLowerBound());
   const Point upperBound(interval_.getUpperBound());
@@ -143,16 +255,13 @@ Sample MorrisExperimentLHS::generateTrajectory(const UnsignedInteger index) cons
   // Set the first starting point
   for (UnsignedInteger p = 0; p < dimension; ++p) trajectoryPath(0, p) = xBase[p];
 
-  // Define the direction +/-
-  Point directions(directionDistribution.getSample(dimension).getImplementation()->getData());
-
   for (UnsignedInteger i = 0; i < dimension; ++i)
   {
     // Computing trajectoryPath[i+1]
     // Set the new 'starting' point to the last element of trajectory
     xBase = trajectoryPath[i];
     // Select the axis to be updated
-    const UnsignedInteger axis(permutations[i]);
+    const UnsignedInteger axis(permutation[i]);
     // new x[axis] should be xBase[axis] + delta[axis] * direction[i]
     // We check that new point belongs to the interval otherwise
     // we try the alternative point xBase[axis] - delta[axis] * direction[i]
@@ -195,5 +304,28 @@ void MorrisExperimentLHS::load(Advocate & adv)
   adv.loadAttribute( "experiment_", experiment_ );
 }
 
+/* Compact binary state of the parameters, used for pickling */
+void MorrisExperimentLHS::saveBinary(std::ostream & stream) const
+{
+  MorrisExperiment::saveBinary(stream);
+  // The LHS design is written row-major
+  const std::uint64_t size = experiment_.getSize();
+  stream.write(reinterpret_cast<const char *>(&size), sizeof(size));
+  if (size > 0)
+    stream.write(reinterpret_cast<const char *>(&experiment_(0, 0)), size * experiment_.getDimension() * sizeof(Scalar));
+}
+
+void MorrisExperimentLHS::loadBinary(std::istream & stream)
+{
+  MorrisExperiment::loadBinary(stream);
+  std::uint64_t size = 0;
+  stream.read(reinterpret_cast<char *>(&size), sizeof(size));
+  experiment_ = Sample(size, delta_.getSize());
+  if (size > 0)
+    stream.read(reinterpret_cast<char *>(&experiment_(0, 0)), size * experiment_.getDimension() * sizeof(Scalar));
+  if (!stream)
+    throw FileNotFoundException(HERE) << "In MorrisExperimentLHS::loadBinary, truncated state";
+}
+
 
 } /* namespace OTMORRIS */
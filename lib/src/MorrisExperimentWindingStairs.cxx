@@ -0,0 +1,178 @@
+//                                               -*- C++ -*-
+/**
+ *  @brief MorrisExperimentWindingStairs defines winding stairs experiments
+ *  for the Morris method on p-level grids
+ *
+ *  Copyright 2005-2018 Airbus-EDF-IMACS-Phimeca
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License.
+ *
+ *  This library is distributed in the hope that it will be useful
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+ *
+ */
+#include <openturns/PersistentObjectFactory.hxx>
+#include "otmorris/MorrisExperimentWindingStairs.hxx"
+#include <openturns/RandomGenerator.hxx>
+#include "otmorris/RandomStream.hxx"
+#include <istream>
+
+using namespace OT;
+
+namespace OTMORRIS
+{
+
+CLASSNAMEINIT(MorrisExperimentWindingStairs)
+
+static const Factory<MorrisExperimentWindingStairs> Factory_MorrisExperimentWindingStairs;
+
+
+/** Constructor using a p-level grid  - Uniform(0,1)^d */
+MorrisExperimentWindingStairs::MorrisExperimentWindingStairs(const Indices & levels, const UnsignedInteger N)
+  : MorrisExperiment(Point(levels.getSize()), Interval(levels.getSize()), N)
+{
+  for (UnsignedInteger k = 0; k < levels.getSize(); ++k)
+  {
+    if (!(levels[k] > 1))
+      throw InvalidArgumentException(HERE) << "Levels should be at least 2; levels[" << k << "]=" << levels[k];
+    delta_[k] = 1.0 / (levels[k] - 1.0);
+  }
+  setTrajectoryNumber(N);
+}
+
+/** Constructor using a p-level grid and intervals*/
+MorrisExperimentWindingStairs::MorrisExperimentWindingStairs(const Indices & levels, const Interval & interval, const UnsignedInteger N)
+  : MorrisExperiment(Point(levels.getSize()), interval, N)
+{
+  for (UnsignedInteger k = 0; k < levels.getSize(); ++k)
+  {
+    if (!(levels[k] > 1))
+      throw InvalidArgumentException(HERE) << "Levels should be at least 2; levels[" << k << "]=" << levels[k];
+    delta_[k] = 1.0 / (levels[k] - 1.0);
+  }
+  setTrajectoryNumber(N);
+}
+
+/* Virtual constructor method */
+MorrisExperimentWindingStairs * MorrisExperimentWindingStairs::clone() const
+{
+  return new MorrisExperimentWindingStairs(*this);
+}
+
+/* Number of trajectories accessor */
+void MorrisExperimentWindingStairs::setTrajectoryNumber(const UnsignedInteger N)
+{
+  if (N == 0)
+    throw InvalidArgumentException(HERE) << "In MorrisExperimentWindingStairs, the number of trajectories should be positive";
+  N_ = N;
+  // Consecutive trajectories share one point
+  setSize(N * delta_.getSize() + 1);
+}
+
+/* Number of points between the starts of two consecutive trajectories */
+UnsignedInteger MorrisExperimentWindingStairs::getTrajectoryStride() const
+{
+  return delta_.getSize();
+}
+
+// Move a factor by one level in a random direction, reversed at the bounds of the grid
+static void MoveFactor(UnsignedInteger & position, const UnsignedInteger levels, RandomStream & stream)
+{
+  Bool up = (stream.integerGenerate(2) == 1);
+  if (up && (position + 1 == levels)) up = false;
+  else if (!up && (position == 0)) up = true;
+  position = (up ? position + 1 : position - 1);
+}
+
+/* Chain of the cycles firstCycle to firstCycle + cycleNumber - 1, fully determined by the seed */
+Sample MorrisExperimentWindingStairs::buildChain(const UnsignedInteger firstCycle, const UnsignedInteger cycleNumber, const UnsignedInteger seed) const
+{
+  const UnsignedInteger dimension = delta_.getDimension();
+  const Point lowerBound(interval_.getLowerBound());
+  const Point deltaBounds(interval_.getUpperBound() - lowerBound);
+  // Positions are kept in grid units so that the chain does not drift off the grid
+  Indices levels(dimension);
+  Indices position(dimension);
+  RandomStream baseStream(seed, 0);
+  for (UnsignedInteger k = 0; k < dimension; ++k)
+  {
+    levels[k] = getLevelNumber(k);
+    position[k] = baseStream.integerGenerate(levels[k]);
+  }
+  // Each cycle has its own stream: the cycles before the first one are only replayed on the positions,
+  // which costs d draws per cycle but no memory
+  for (UnsignedInteger cycle = 0; cycle < firstCycle; ++cycle)
+  {
+    RandomStream stream(seed, cycle + 1);
+    for (UnsignedInteger k = 0; k < dimension; ++k) MoveFactor(position[k], levels[k], stream);
+  }
+  Sample chain(cycleNumber * dimension + 1, dimension);
+  for (UnsignedInteger k = 0; k < dimension; ++k)
+    chain(0, k) = lowerBound[k] + deltaBounds[k] * delta_[k] * position[k];
+  for (UnsignedInteger cycle = 0; cycle < cycleNumber; ++cycle)
+  {
+    RandomStream stream(seed, firstCycle + cycle + 1);
+    for (UnsignedInteger k = 0; k < dimension; ++k)
+    {
+      const UnsignedInteger step = cycle * dimension + k + 1;
+      for (UnsignedInteger j = 0; j < dimension; ++j) chain(step, j) = chain(step - 1, j);
+      // Move the k-th factor by one level, in the feasible direction
+      MoveFactor(position[k], levels[k], stream);
+      chain(step, k) = lowerBound[k] + deltaBounds[k] * delta_[k] * position[k];
+    }
+  }
+  return chain;
+}
+
+/** Generate the chain of N*d+1 points */
+Sample MorrisExperimentWindingStairs::generate() const
+{
+  // The chain is drawn from its own streams, seeded from the shared generator
+  const UnsignedInteger seed = RandomGenerator::IntegerGenerate(1, 2147483647)[0];
+  return buildChain(0, N_, seed);
+}
+
+/** Generate the trajectories of one shard of a reproducible chain, as separate blocks of d+1 points */
+Sample MorrisExperimentWindingStairs::generate(const UnsignedInteger shardIndex, const UnsignedInteger shardCount, const UnsignedInteger seed) const
+{
+  UnsignedInteger first = 0;
+  UnsignedInteger last = 0;
+  computeShardRange(shardIndex, shardCount, first, last);
+  const UnsignedInteger dimension = delta_.getDimension();
+  // Only the points of the shard are stored, the moves of the previous cycles being replayed
+  const Sample chain(buildChain(first, last - first, seed));
+  Sample realizations((last - first) * (dimension + 1), dimension);
+  for (UnsignedInteger k = 0; k < last - first; ++k)
+    for (UnsignedInteger i = 0; i <= dimension; ++i)
+      for (UnsignedInteger j = 0; j < dimension; ++j)
+        realizations(k * (dimension + 1) + i, j) = chain(k * dimension + i, j);
+  return realizations;
+}
+
+/* Compact binary state of the parameters, used for pickling */
+void MorrisExperimentWindingStairs::loadBinary(std::istream & stream)
+{
+  MorrisExperiment::loadBinary(stream);
+  setTrajectoryNumber(N_);
+}
+
+/* String converter */
+String MorrisExperimentWindingStairs::__repr__() const
+{
+  OSS oss;
+  oss << "class=" << MorrisExperimentWindingStairs::GetClassName()
+      << ", trajectories=" << N_;
+  return oss;
+}
+
+
+} /* namespace OTMORRIS */
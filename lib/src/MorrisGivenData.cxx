@@ -0,0 +1,231 @@
+//                                               -*- C++ -*-
+/**
+ *  @brief MorrisGivenData
+ *
+ *  Copyright 2005-2018 Airbus-EDF-IMACS-Phimeca
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License.
+ *
+ *  This library is distributed in the hope that it will be useful
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+ *
+ */
+#include "otmorris/MorrisGivenData.hxx"
+#include <openturns/Exception.hxx>
+#include <openturns/KDTree.hxx>
+#include <openturns/Log.hxx>
+#include <openturns/TBBImplementation.hxx>
+#include <cmath>
+#include <vector>
+
+using namespace OT;
+
+namespace OTMORRIS
+{
+
+CLASSNAMEINIT(MorrisGivenData)
+
+// Nearest neighbour of each point along each input, -1 if none is aligned enough
+struct GivenDataPairPolicy
+{
+  const Sample & points_;
+  const KDTree & tree_;
+  const UnsignedInteger neighbourNumber_;
+  const Scalar alignment_;
+  SignedInteger * partners_;
+
+  GivenDataPairPolicy(const Sample & points, const KDTree & tree, const UnsignedInteger neighbourNumber,
+                      const Scalar alignment, SignedInteger * partners)
+    : points_(points)
+    , tree_(tree)
+    , neighbourNumber_(neighbourNumber)
+    , alignment_(alignment)
+    , partners_(partners)
+  {}
+
+  inline void operator()(const TBBImplementation::BlockedRange<UnsignedInteger> & r) const
+  {
+    const UnsignedInteger dimension = points_.getDimension();
+    for (UnsignedInteger n = r.begin(); n != r.end(); ++n)
+    {
+      SignedInteger * partners = partners_ + n * dimension;
+      for (UnsignedInteger i = 0; i < dimension; ++i) partners[i] = -1;
+      const Point point(points_[n]);
+      // Neighbours come by increasing distance, the point itself being the first one
+      const Indices neighbours(tree_.queryK(point, neighbourNumber_ + 1, true));
+      UnsignedInteger found = 0;
+      for (UnsignedInteger k = 0; (k < neighbours.getSize()) && (found < dimension); ++k)
+      {
+        const UnsignedInteger neighbour = neighbours[k];
+        if (neighbour == n) continue;
+        // Main axis of the difference, and its share of the distance
+        UnsignedInteger axis = 0;
+        Scalar squaredDistance = 0.0;
+        Scalar largest = 0.0;
+        for (UnsignedInteger j = 0; j < dimension; ++j)
+        {
+          const Scalar delta = std::abs(points_(neighbour, j) - point[j]);
+          squaredDistance += delta * delta;
+          if (delta > largest)
+          {
+            largest = delta;
+            axis = j;
+          }
+        }
+        if (!(largest > 0.0) || (partners[axis] >= 0)) continue;
+        if (largest >= alignment_ * std::sqrt(squaredDistance))
+        {
+          partners[axis] = neighbour;
+          ++ found;
+        }
+      }
+    }
+  }
+
+}; /* end struct GivenDataPairPolicy */
+
+/* Default constructor */
+MorrisGivenData::MorrisGivenData()
+  : Object()
+  , neighbourNumber_(0)
+  , alignment_(0.0)
+  , pairs_()
+  , elementaryEffectsMean_()
+  , absoluteElementaryEffectsMean_()
+  , elementaryEffectsStandardDeviation_()
+{
+  // Nothing to do
+}
+
+/* Constructor from samples */
+MorrisGivenData::MorrisGivenData(const Sample & inputSample, const Sample & outputSample, const Interval & interval,
+                                 const UnsignedInteger neighbourNumber, const Scalar alignment)
+  : Object()
+  , neighbourNumber_(neighbourNumber)
+  , alignment_(alignment)
+  , pairs_()
+  , elementaryEffectsMean_()
+  , absoluteElementaryEffectsMean_()
+  , elementaryEffectsStandardDeviation_()
+{
+  const UnsignedInteger size = inputSample.getSize();
+  const UnsignedInteger inputDimension = interval.getDimension();
+  const UnsignedInteger outputDimension = outputSample.getDimension();
+  if (outputSample.getSize() != size)
+    throw InvalidArgumentException(HERE) << "In MorrisGivenData, input & output samples should be of same size. Here, input sample's size=" << size
+                                         << ", output sample's size=" << outputSample.getSize();
+  if (inputSample.getDimension() != inputDimension)
+    throw InvalidDimensionException(HERE) << "In MorrisGivenData, input sample should be of dimension " << inputDimension
+                                          << ", here dimension=" << inputSample.getDimension();
+  if (size < 2)
+    throw InvalidArgumentException(HERE) << "In MorrisGivenData, at least two points are needed, here " << size;
+  if (neighbourNumber == 0)
+    throw InvalidArgumentException(HERE) << "In MorrisGivenData, the number of neighbours should be positive";
+  if (!(alignment > 0.0) || (alignment > 1.0))
+    throw InvalidArgumentException(HERE) << "In MorrisGivenData, the alignment should be in (0, 1], here alignment=" << alignment;
+
+  // Distances are measured in the unit cube so that all the inputs weigh the same
+  const Point lowerBound(interval.getLowerBound());
+  const Point diffBounds(interval.getUpperBound() - lowerBound);
+  Sample points(size, inputDimension);
+  for (UnsignedInteger n = 0; n < size; ++n)
+    for (UnsignedInteger j = 0; j < inputDimension; ++j)
+      points(n, j) = (inputSample(n, j) - lowerBound[j]) / diffBounds[j];
+  const KDTree tree(points);
+  std::vector<SignedInteger> partners(size * inputDimension);
+  const GivenDataPairPolicy policy(points, tree, std::min(neighbourNumber, size - 1), alignment, partners.data());
+  TBBImplementation::ParallelFor(0, size, policy);
+
+  // Mutual pairs are counted once, from their first point
+  pairs_ = Collection<Indices>(inputDimension);
+  elementaryEffectsMean_ = Sample(outputDimension, inputDimension);
+  absoluteElementaryEffectsMean_ = Sample(outputDimension, inputDimension);
+  elementaryEffectsStandardDeviation_ = Sample(outputDimension, inputDimension);
+  for (UnsignedInteger n = 0; n < size; ++n)
+    for (UnsignedInteger i = 0; i < inputDimension; ++i)
+    {
+      const SignedInteger partner = partners[n * inputDimension + i];
+      if (partner < 0) continue;
+      const UnsignedInteger other = partner;
+      if ((other < n) && (partners[other * inputDimension + i] == static_cast<SignedInteger>(n))) continue;
+      pairs_[i].add(n);
+      pairs_[i].add(other);
+      const Scalar step = points(other, i) - points(n, i);
+      const Scalar pairNumber = pairs_[i].getSize() / 2;
+      for (UnsignedInteger j = 0; j < outputDimension; ++j)
+      {
+        // Welford update of the statistics of the input
+        const Scalar effect = (outputSample(other, j) - outputSample(n, j)) / step;
+        const Scalar delta = effect - elementaryEffectsMean_(j, i);
+        elementaryEffectsMean_(j, i) += delta / pairNumber;
+        absoluteElementaryEffectsMean_(j, i) += (std::abs(effect) - absoluteElementaryEffectsMean_(j, i)) / pairNumber;
+        elementaryEffectsStandardDeviation_(j, i) += delta * (effect - elementaryEffectsMean_(j, i));
+      }
+    }
+  for (UnsignedInteger i = 0; i < inputDimension; ++i)
+  {
+    const Scalar pairNumber = pairs_[i].getSize() / 2;
+    if (pairNumber == 0)
+      LOGWARN(OSS() << "In MorrisGivenData, no pair of points is aligned with input " << i << ", its statistics are zero");
+    for (UnsignedInteger j = 0; j < outputDimension; ++j)
+      elementaryEffectsStandardDeviation_(j, i) = (pairNumber > 1 ? std::sqrt(elementaryEffectsStandardDeviation_(j, i) / (pairNumber - 1.0)) : 0.0);
+  }
+  LOGINFO(OSS() << "Given-data Morris on " << size << " points, pairs per input=" << getPairNumber());
+}
+
+/* Number of pairs per input */
+Indices MorrisGivenData::getPairNumber() const
+{
+  Indices pairNumber(pairs_.getSize());
+  for (UnsignedInteger i = 0; i < pairs_.getSize(); ++i)
+    pairNumber[i] = pairs_[i].getSize() / 2;
+  return pairNumber;
+}
+
+/* Pairs of point indices used for an input */
+Indices MorrisGivenData::getPairs(const UnsignedInteger input) const
+{
+  if (input >= pairs_.getSize()) throw InvalidArgumentException(HERE) << "Cannot exceed dimension";
+  return pairs_[input];
+}
+
+/* Statistics of the elementary effects of the pairs */
+Point MorrisGivenData::getMeanElementaryEffects(const UnsignedInteger outputMarginal) const
+{
+  if (outputMarginal >= elementaryEffectsMean_.getSize()) throw InvalidArgumentException(HERE) << "Cannot exceed dimension";
+  return elementaryEffectsMean_[outputMarginal];
+}
+
+Point MorrisGivenData::getMeanAbsoluteElementaryEffects(const UnsignedInteger outputMarginal) const
+{
+  if (outputMarginal >= absoluteElementaryEffectsMean_.getSize()) throw InvalidArgumentException(HERE) << "Cannot exceed dimension";
+  return absoluteElementaryEffectsMean_[outputMarginal];
+}
+
+Point MorrisGivenData::getStandardDeviationElementaryEffects(const UnsignedInteger outputMarginal) const
+{
+  if (outputMarginal >= elementaryEffectsStandardDeviation_.getSize()) throw InvalidArgumentException(HERE) << "Cannot exceed dimension";
+  return elementaryEffectsStandardDeviation_[outputMarginal];
+}
+
+/* String converter */
+String MorrisGivenData::__repr__() const
+{
+  OSS oss;
+  oss << "class=" << MorrisGivenData::GetClassName()
+      << ", neighbours=" << neighbourNumber_
+      << ", alignment=" << alignment_
+      << ", pairs per input=" << getPairNumber();
+  return oss;
+}
+
+} /* namespace OTMORRIS */
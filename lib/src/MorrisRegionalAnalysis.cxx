@@ -0,0 +1,379 @@
+//                                               -*- C++ -*-
+/**
+ *  @brief MorrisRegionalAnalysis
+ *
+ *  Copyright 2005-2018 Airbus-EDF-IMACS-Phimeca
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License.
+ *
+ *  This library is distributed in the hope that it will be useful
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+ *
+ */
+#include "otmorris/MorrisRegionalAnalysis.hxx"
+#include <openturns/Exception.hxx>
+#include <openturns/Log.hxx>
+#include <openturns/SpecFunc.hxx>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace OT;
+
+namespace OTMORRIS
+{
+
+CLASSNAMEINIT(MorrisRegionalAnalysis)
+
+/* Default constructor */
+MorrisRegionalAnalysis::MorrisRegionalAnalysis()
+  : Object()
+  , regions_()
+  , regionIndices_()
+  , trajectoryNumber_()
+  , elementaryEffectsMean_()
+  , absoluteElementaryEffectsMean_()
+  , elementaryEffectsStandardDeviation_()
+{
+  // Nothing to do
+}
+
+/* Constructor with a regular grid of binNumber[j] cells along input j */
+MorrisRegionalAnalysis::MorrisRegionalAnalysis(const Morris & morris, const Indices & binNumber)
+  : Object()
+  , regions_()
+  , regionIndices_()
+  , trajectoryNumber_()
+  , elementaryEffectsMean_()
+  , absoluteElementaryEffectsMean_()
+  , elementaryEffectsStandardDeviation_()
+{
+  const Interval & interval = morris.interval_;
+  const UnsignedInteger inputDimension = interval.getDimension();
+  if (binNumber.getSize() != inputDimension)
+    throw InvalidDimensionException(HERE) << "In MorrisRegionalAnalysis, expected " << inputDimension << " bin numbers, here " << binNumber.getSize();
+  UnsignedInteger regionNumber = 1;
+  for (UnsignedInteger j = 0; j < inputDimension; ++j)
+  {
+    if (binNumber[j] == 0)
+      throw InvalidArgumentException(HERE) << "In MorrisRegionalAnalysis, the bin numbers should be positive, here binNumber=" << binNumber;
+    regionNumber *= binNumber[j];
+  }
+  const Point lowerBound(interval.getLowerBound());
+  const Point upperBound(interval.getUpperBound());
+
+  // Cells are numbered in mixed radix, the first input varying fastest
+  regions_ = IntervalCollection(regionNumber, Interval(inputDimension));
+  for (UnsignedInteger r = 0; r < regionNumber; ++r)
+  {
+    Point cellLowerBound(inputDimension);
+    Point cellUpperBound(inputDimension);
+    UnsignedInteger index = r;
+    for (UnsignedInteger j = 0; j < inputDimension; ++j)
+    {
+      const UnsignedInteger bin = index % binNumber[j];
+      index /= binNumber[j];
+      const Scalar width = (upperBound[j] - lowerBound[j]) / binNumber[j];
+      cellLowerBound[j] = lowerBound[j] + bin * width;
+      cellUpperBound[j] = (bin + 1 == binNumber[j] ? upperBound[j] : lowerBound[j] + (bin + 1) * width);
+    }
+    regions_[r] = Interval(cellLowerBound, cellUpperBound);
+  }
+
+  const Sample basePoints(ComputeBasePoints(morris));
+  const UnsignedInteger size = basePoints.getSize();
+  regionIndices_ = Indices(size);
+  for (UnsignedInteger k = 0; k < size; ++k)
+  {
+    UnsignedInteger region = 0;
+    UnsignedInteger radix = 1;
+    for (UnsignedInteger j = 0; j < inputDimension; ++j)
+    {
+      // Points on the upper bound belong to the last cell
+      const Scalar position = (basePoints(k, j) - lowerBound[j]) / (upperBound[j] - lowerBound[j]) * binNumber[j];
+      const UnsignedInteger bin = (position <= 0.0 ? 0 : std::min(static_cast<UnsignedInteger>(position), binNumber[j] - 1));
+      region += bin * radix;
+      radix *= binNumber[j];
+    }
+    regionIndices_[k] = region;
+  }
+  run(morris);
+}
+
+/* Constructor with the leaves of a k-d tree holding at most leafSize base points */
+MorrisRegionalAnalysis::MorrisRegionalAnalysis(const Morris & morris, const UnsignedInteger leafSize)
+  : Object()
+  , regions_()
+  , regionIndices_()
+  , trajectoryNumber_()
+  , elementaryEffectsMean_()
+  , absoluteElementaryEffectsMean_()
+  , elementaryEffectsStandardDeviation_()
+{
+  if (leafSize == 0)
+    throw InvalidArgumentException(HERE) << "In MorrisRegionalAnalysis, the leaf size should be positive";
+  const Sample basePoints(ComputeBasePoints(morris));
+  const UnsignedInteger size = basePoints.getSize();
+  regionIndices_ = Indices(size);
+  Indices indices(size);
+  indices.fill();
+  buildKDCells(basePoints, indices, morris.interval_, leafSize);
+  run(morris);
+}
+
+/* Constructor with a function mapping a base point to its region index */
+MorrisRegionalAnalysis::MorrisRegionalAnalysis(const Morris & morris, const Function & regionFunction)
+  : Object()
+  , regions_()
+  , regionIndices_()
+  , trajectoryNumber_()
+  , elementaryEffectsMean_()
+  , absoluteElementaryEffectsMean_()
+  , elementaryEffectsStandardDeviation_()
+{
+  const Interval & interval = morris.interval_;
+  const UnsignedInteger inputDimension = interval.getDimension();
+  if (regionFunction.getInputDimension() != inputDimension)
+    throw InvalidDimensionException(HERE) << "In MorrisRegionalAnalysis, the region function should have an input dimension=" << inputDimension
+                                          << ", here input dimension=" << regionFunction.getInputDimension();
+  if (regionFunction.getOutputDimension() != 1)
+    throw InvalidDimensionException(HERE) << "In MorrisRegionalAnalysis, the region function should have an output dimension=1, here output dimension="
+                                          << regionFunction.getOutputDimension();
+  const Sample basePoints(ComputeBasePoints(morris));
+  const Sample values(regionFunction(basePoints));
+  const UnsignedInteger size = basePoints.getSize();
+  regionIndices_ = Indices(size);
+  UnsignedInteger regionNumber = 0;
+  for (UnsignedInteger k = 0; k < size; ++k)
+  {
+    const Scalar value = values(k, 0);
+    if (!(value > -0.5))
+      throw InvalidArgumentException(HERE) << "In MorrisRegionalAnalysis, the region function should return non-negative indices, here f("
+                                           << basePoints[k] << ")=" << value;
+    regionIndices_[k] = static_cast<UnsignedInteger>(value + 0.5);
+    regionNumber = std::max(regionNumber, regionIndices_[k] + 1);
+  }
+
+  // Bounding box of the base points of each region, empty regions get an empty interval
+  const Point lowerBound(interval.getLowerBound());
+  const Point upperBound(interval.getUpperBound());
+  Sample cellLowerBounds(regionNumber, upperBound);
+  Sample cellUpperBounds(regionNumber, lowerBound);
+  for (UnsignedInteger k = 0; k < size; ++k)
+  {
+    const UnsignedInteger region = regionIndices_[k];
+    for (UnsignedInteger j = 0; j < inputDimension; ++j)
+    {
+      cellLowerBounds(region, j) = std::min(cellLowerBounds(region, j), basePoints(k, j));
+      cellUpperBounds(region, j) = std::max(cellUpperBounds(region, j), basePoints(k, j));
+    }
+  }
+  regions_ = IntervalCollection(regionNumber, Interval(inputDimension));
+  for (UnsignedInteger r = 0; r < regionNumber; ++r)
+    regions_[r] = Interval(cellLowerBounds[r], cellUpperBounds[r]);
+  run(morris);
+}
+
+/* Base point of each trajectory */
+Sample MorrisRegionalAnalysis::ComputeBasePoints(const Morris & morris)
+{
+  const UnsignedInteger stride = morris.computeSampleStride();
+  const UnsignedInteger size = morris.trajectoryNumber_;
+  const UnsignedInteger inputDimension = morris.interval_.getDimension();
+  Sample basePoints(size, inputDimension);
+  for (UnsignedInteger k = 0; k < size; ++k)
+    for (UnsignedInteger j = 0; j < inputDimension; ++j)
+      basePoints(k, j) = morris.inputSample_(k * stride, j);
+  return basePoints;
+}
+
+/* Split the base points of the indices into k-d cells */
+void MorrisRegionalAnalysis::buildKDCells(const Sample & basePoints, const Indices & indices, const Interval & cell, const UnsignedInteger leafSize)
+{
+  const UnsignedInteger size = indices.getSize();
+  const UnsignedInteger inputDimension = basePoints.getDimension();
+  // Split along the input with the largest spread of the base points
+  UnsignedInteger splitDimension = 0;
+  Scalar largestSpread = 0.0;
+  if (size > leafSize)
+    for (UnsignedInteger j = 0; j < inputDimension; ++j)
+    {
+      Scalar minimum = SpecFunc::MaxScalar;
+      Scalar maximum = -SpecFunc::MaxScalar;
+      for (UnsignedInteger i = 0; i < size; ++i)
+      {
+        minimum = std::min(minimum, basePoints(indices[i], j));
+        maximum = std::max(maximum, basePoints(indices[i], j));
+      }
+      if (maximum - minimum > largestSpread)
+      {
+        largestSpread = maximum - minimum;
+        splitDimension = j;
+      }
+    }
+  // Leaf, possibly larger than leafSize if all its base points are equal
+  if (!(largestSpread > 0.0))
+  {
+    const UnsignedInteger region = regions_.getSize();
+    for (UnsignedInteger i = 0; i < size; ++i)
+      regionIndices_[indices[i]] = region;
+    regions_.add(cell);
+    return;
+  }
+
+  // Split at the median, moved to the nearest change of value so that ties stay together
+  std::vector<Scalar> values(size);
+  for (UnsignedInteger i = 0; i < size; ++i)
+    values[i] = basePoints(indices[i], splitDimension);
+  std::sort(values.begin(), values.end());
+  const UnsignedInteger median = size / 2;
+  const UnsignedInteger lower = std::lower_bound(values.begin(), values.end(), values[median]) - values.begin();
+  const UnsignedInteger upper = std::upper_bound(values.begin(), values.end(), values[median]) - values.begin();
+  const UnsignedInteger split = ((lower > 0) && ((upper == size) || (median - lower <= upper - median)) ? lower : upper);
+  const Scalar splitValue = values[split];
+
+  Indices leftIndices;
+  Indices rightIndices;
+  for (UnsignedInteger i = 0; i < size; ++i)
+  {
+    if (basePoints(indices[i], splitDimension) < splitValue) leftIndices.add(indices[i]);
+    else rightIndices.add(indices[i]);
+  }
+  Point leftUpperBound(cell.getUpperBound());
+  leftUpperBound[splitDimension] = splitValue;
+  Point rightLowerBound(cell.getLowerBound());
+  rightLowerBound[splitDimension] = splitValue;
+  buildKDCells(basePoints, leftIndices, Interval(cell.getLowerBound(), leftUpperBound), leafSize);
+  buildKDCells(basePoints, rightIndices, Interval(rightLowerBound, cell.getUpperBound()), leafSize);
+}
+
+/* Accumulate the statistics of each region in one pass over the trajectories */
+void MorrisRegionalAnalysis::run(const Morris & morris)
+{
+  const UnsignedInteger stride = morris.computeSampleStride();
+  const UnsignedInteger inputDimension = morris.interval_.getDimension();
+  const UnsignedInteger outputDimension = morris.outputSample_.getDimension();
+  const UnsignedInteger regionNumber = regions_.getSize();
+  const Point diffBounds(morris.interval_.getUpperBound() - morris.interval_.getLowerBound());
+  trajectoryNumber_ = Indices(regionNumber);
+  elementaryEffectsMean_ = SampleCollection(regionNumber, Sample(outputDimension, inputDimension));
+  absoluteElementaryEffectsMean_ = SampleCollection(regionNumber, Sample(outputDimension, inputDimension));
+  // Holds the sums of squared deviations until the end of the pass
+  elementaryEffectsStandardDeviation_ = SampleCollection(regionNumber, Sample(outputDimension, inputDimension));
+
+  Point x((inputDimension + 1) * inputDimension);
+  Point y((inputDimension + 1) * outputDimension);
+  Point ee(inputDimension * outputDimension);
+  for (UnsignedInteger k = 0; k < regionIndices_.getSize(); ++k)
+  {
+    for (UnsignedInteger i = 0; i <= inputDimension; ++i)
+    {
+      for (UnsignedInteger j = 0; j < inputDimension; ++j)
+        x[i * inputDimension + j] = morris.inputSample_(k * stride + i, j);
+      for (UnsignedInteger j = 0; j < outputDimension; ++j)
+        y[i * outputDimension + j] = morris.outputSample_(k * stride + i, j);
+    }
+    Morris::ComputeTrajectoryEffects(&x[0], &y[0], diffBounds, outputDimension, &ee[0]);
+    // Welford update of the statistics of the region
+    const UnsignedInteger region = regionIndices_[k];
+    const Scalar size = ++ trajectoryNumber_[region];
+    Sample & mean = elementaryEffectsMean_[region];
+    Sample & absoluteMean = absoluteElementaryEffectsMean_[region];
+    Sample & squaredDeviations = elementaryEffectsStandardDeviation_[region];
+    for (UnsignedInteger marginal = 0; marginal < outputDimension; ++marginal)
+      for (UnsignedInteger i = 0; i < inputDimension; ++i)
+      {
+        const Scalar effect = ee[i + marginal * inputDimension];
+        const Scalar delta = effect - mean(marginal, i);
+        mean(marginal, i) += delta / size;
+        absoluteMean(marginal, i) += (std::abs(effect) - absoluteMean(marginal, i)) / size;
+        squaredDeviations(marginal, i) += delta * (effect - mean(marginal, i));
+      }
+  }
+  for (UnsignedInteger r = 0; r < regionNumber; ++r)
+  {
+    const Scalar size = trajectoryNumber_[r];
+    Sample & standardDeviation = elementaryEffectsStandardDeviation_[r];
+    for (UnsignedInteger marginal = 0; marginal < outputDimension; ++marginal)
+      for (UnsignedInteger i = 0; i < inputDimension; ++i)
+        standardDeviation(marginal, i) = (size > 1.0 ? std::sqrt(standardDeviation(marginal, i) / (size - 1.0)) : 0.0);
+  }
+  LOGINFO(OSS() << "Computed the Morris statistics of " << regionNumber << " regions from " << regionIndices_.getSize() << " trajectories");
+}
+
+/* Check a region/marginal pair */
+void MorrisRegionalAnalysis::checkRegion(const UnsignedInteger region, const UnsignedInteger outputMarginal) const
+{
+  if (region >= regions_.getSize())
+    throw OutOfBoundException(HERE) << "In MorrisRegionalAnalysis, region=" << region << " should be less than " << regions_.getSize();
+  if (outputMarginal >= elementaryEffectsMean_[region].getSize()) throw InvalidArgumentException(HERE) << "Cannot exceed dimension";
+}
+
+/* Number of regions accessor */
+UnsignedInteger MorrisRegionalAnalysis::getRegionNumber() const
+{
+  return regions_.getSize();
+}
+
+/* Bounds of a region */
+Interval MorrisRegionalAnalysis::getRegion(const UnsignedInteger region) const
+{
+  if (region >= regions_.getSize())
+    throw OutOfBoundException(HERE) << "In MorrisRegionalAnalysis, region=" << region << " should be less than " << regions_.getSize();
+  return regions_[region];
+}
+
+/* Region of each trajectory */
+Indices MorrisRegionalAnalysis::getRegionIndices() const
+{
+  return regionIndices_;
+}
+
+/* Number of trajectories of a region */
+UnsignedInteger MorrisRegionalAnalysis::getTrajectoryNumber(const UnsignedInteger region) const
+{
+  if (region >= regions_.getSize())
+    throw OutOfBoundException(HERE) << "In MorrisRegionalAnalysis, region=" << region << " should be less than " << regions_.getSize();
+  return trajectoryNumber_[region];
+}
+
+/* Statistics of the elementary effects of a region */
+Point MorrisRegionalAnalysis::getMeanElementaryEffects(const UnsignedInteger region, const UnsignedInteger outputMarginal) const
+{
+  checkRegion(region, outputMarginal);
+  return elementaryEffectsMean_[region][outputMarginal];
+}
+
+Point MorrisRegionalAnalysis::getMeanAbsoluteElementaryEffects(const UnsignedInteger region, const UnsignedInteger outputMarginal) const
+{
+  checkRegion(region, outputMarginal);
+  return absoluteElementaryEffectsMean_[region][outputMarginal];
+}
+
+Point MorrisRegionalAnalysis::getStandardDeviationElementaryEffects(const UnsignedInteger region, const UnsignedInteger outputMarginal) const
+{
+  checkRegion(region, outputMarginal);
+  return elementaryEffectsStandardDeviation_[region][outputMarginal];
+}
+
+/* String converter */
+String MorrisRegionalAnalysis::__repr__() const
+{
+  OSS oss;
+  oss << "class=" << MorrisRegionalAnalysis::GetClassName()
+      << ", regions=" << regions_.getSize()
+      << ", trajectories=" << regionIndices_.getSize()
+      << ", trajectories per region=" << trajectoryNumber_;
+  return oss;
+}
+
+} /* namespace OTMORRIS */
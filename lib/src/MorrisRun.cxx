@@ -0,0 +1,274 @@
+//                                               -*- C++ -*-
+/**
+ *  @brief MorrisRun
+ *
+ *  Copyright 2005-2018 Airbus-EDF-IMACS-Phimeca
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License.
+ *
+ *  This library is distributed in the hope that it will be useful
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+ *
+ */
+#include "otmorris/MorrisRun.hxx"
+#include <openturns/Exception.hxx>
+#include <openturns/Log.hxx>
+#include <openturns/SpecFunc.hxx>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+using namespace OT;
+
+namespace OTMORRIS
+{
+
+/* State shared by the handles and the background thread */
+class MorrisRunState
+{
+public:
+  MorrisRunState(const MorrisExperiment & experiment, const Function & model, const UnsignedInteger blockSize)
+    : inputSample_(experiment.generate())
+    , stride_(experiment.getTrajectoryStride())
+    , model_(model)
+    , blockSize_(blockSize)
+    , totalEvaluationNumber_(inputSample_.getSize())
+    , evaluationNumber_(0)
+    , evaluationTime_(0.0)
+    , cancelled_(false)
+    , stoppedEarly_(false)
+    , done_(false)
+    , snapshot_()
+    , promise_()
+    , future_(promise_.get_future().share())
+    , start_(std::chrono::steady_clock::now())
+    , thread_()
+  {
+    // The design is generated above by the calling thread, the only one using the shared random generator
+    snapshot_.interval_ = experiment.getBounds();
+    thread_ = std::thread(&MorrisRunState::run, this);
+  }
+
+  ~MorrisRunState()
+  {
+    // The last handle is gone, nobody can get the result anymore
+    cancelled_ = true;
+    if (thread_.joinable()) thread_.join();
+  }
+
+  void run()
+  {
+    try
+    {
+      const UnsignedInteger inputDimension = inputSample_.getDimension();
+      const UnsignedInteger trajectorySize = inputDimension + 1;
+      const UnsignedInteger size = inputSample_.getSize();
+      const UnsignedInteger N = (size < trajectorySize ? 0 : (size - trajectorySize) / stride_ + 1);
+      // Consecutive trajectories share trajectorySize - stride points, eg in winding stairs designs:
+      // the outputs of the points shared with the previous block are carried over
+      const UnsignedInteger sharedSize = trajectorySize - stride_;
+      Sample sharedOutput;
+      UnsignedInteger first = 0;
+      for (; (first < N) && !cancelled_; first += blockSize_)
+      {
+        const UnsignedInteger last = std::min(N, first + blockSize_);
+        const UnsignedInteger begin = first * stride_;
+        const UnsignedInteger end = (last - 1) * stride_ + trajectorySize;
+        const UnsignedInteger carriedSize = (first > 0 ? sharedSize : 0);
+        const Sample blockInput(inputSample_, begin, end);
+        const std::chrono::steady_clock::time_point blockStart(std::chrono::steady_clock::now());
+        const Sample evaluatedOutput(model_(Sample(inputSample_, begin + carriedSize, end)));
+        const Scalar blockTime = std::chrono::duration<Scalar>(std::chrono::steady_clock::now() - blockStart).count();
+        Sample blockOutput(evaluatedOutput);
+        if (carriedSize > 0)
+        {
+          blockOutput = sharedOutput;
+          blockOutput.add(evaluatedOutput);
+        }
+        if (sharedSize > 0)
+          sharedOutput = Sample(blockOutput, blockOutput.getSize() - sharedSize, blockOutput.getSize());
+        // Whole blocks only, so that a snapshot is always a valid result
+        std::lock_guard<std::mutex> lock(mutex_);
+        snapshot_.appendSamples(blockInput, blockOutput, stride_);
+        snapshot_.computeEffects(blockInput, blockOutput, stride_, carriedSize);
+        evaluationNumber_ += evaluatedOutput.getSize();
+        evaluationTime_ += blockTime;
+      }
+      // A cancellation received after the last block does not stop the run
+      stoppedEarly_ = (first < N);
+      if (stoppedEarly_)
+        LOGINFO(OSS() << "MorrisRun cancelled after " << evaluationNumber_ << " evaluations over " << totalEvaluationNumber_);
+      Morris result;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        result = snapshot_;
+      }
+      done_ = true;
+      promise_.set_value(result);
+    }
+    catch (...)
+    {
+      done_ = true;
+      promise_.set_exception(std::current_exception());
+    }
+  }
+
+  const Sample inputSample_;
+  const UnsignedInteger stride_;
+  const Function model_;
+  const UnsignedInteger blockSize_;
+  const UnsignedInteger totalEvaluationNumber_;
+  std::atomic<UnsignedInteger> evaluationNumber_;
+  Scalar evaluationTime_;
+  std::atomic<bool> cancelled_;
+  std::atomic<bool> stoppedEarly_;
+  std::atomic<bool> done_;
+  // Statistics of the evaluated trajectories, guarded by mutex_
+  Morris snapshot_;
+  mutable std::mutex mutex_;
+  std::promise<Morris> promise_;
+  std::shared_future<Morris> future_;
+  const std::chrono::steady_clock::time_point start_;
+  std::thread thread_;
+
+private:
+  MorrisRunState(const MorrisRunState &);
+  MorrisRunState & operator=(const MorrisRunState &);
+};
+
+
+CLASSNAMEINIT(MorrisRun)
+
+/* Default constructor */
+MorrisRun::MorrisRun()
+  : Object()
+  , state_()
+{
+  // Nothing to do
+}
+
+/* Constructor, starts the run */
+MorrisRun::MorrisRun(const MorrisExperiment & experiment, const Function & model, const UnsignedInteger blockSize)
+  : Object()
+  , state_()
+{
+  if (experiment.getSize() == 0)
+    throw InvalidArgumentException(HERE) << "In MorrisRun::MorrisRun, samples should not be empty";
+  if (model.getInputDimension() != experiment.getBounds().getDimension())
+    throw InvalidArgumentException(HERE) << "In MorrisRun::MorrisRun, model should have the same input dimension as the experiment. Here, experiment's dimension=" << experiment.getBounds().getDimension()
+                                         << ", model's input dimension=" << model.getInputDimension();
+  if (blockSize == 0)
+    throw InvalidArgumentException(HERE) << "In MorrisRun::MorrisRun, block size should be positive";
+  state_ = Pointer<MorrisRunState>(new MorrisRunState(experiment, model, blockSize));
+}
+
+/* Number of evaluations done/to do */
+UnsignedInteger MorrisRun::getEvaluationNumber() const
+{
+  if (state_.isNull()) return 0;
+  return state_->evaluationNumber_;
+}
+
+UnsignedInteger MorrisRun::getTotalEvaluationNumber() const
+{
+  if (state_.isNull()) return 0;
+  return state_->totalEvaluationNumber_;
+}
+
+/* Progress, between 0 and 1 */
+Scalar MorrisRun::getProgress() const
+{
+  const UnsignedInteger total = getTotalEvaluationNumber();
+  return (total > 0 ? static_cast<Scalar>(getEvaluationNumber()) / total : 0.0);
+}
+
+/* Time since the start, in seconds */
+Scalar MorrisRun::getElapsedTime() const
+{
+  if (state_.isNull()) return 0.0;
+  return std::chrono::duration<Scalar>(std::chrono::steady_clock::now() - state_->start_).count();
+}
+
+/* Remaining time from the measured time per evaluation, in seconds */
+Scalar MorrisRun::getEstimatedRemainingTime() const
+{
+  if (state_.isNull() || state_->done_) return 0.0;
+  std::lock_guard<std::mutex> lock(state_->mutex_);
+  const UnsignedInteger done = state_->evaluationNumber_;
+  // Unknown until the first block is evaluated
+  if (done == 0) return SpecFunc::MaxScalar;
+  return (state_->totalEvaluationNumber_ - done) * state_->evaluationTime_ / done;
+}
+
+/* Statistics of the trajectories evaluated so far */
+Morris MorrisRun::getSnapshot() const
+{
+  if (state_.isNull())
+    throw NotDefinedException(HERE) << "In MorrisRun::getSnapshot, no run";
+  std::lock_guard<std::mutex> lock(state_->mutex_);
+  return state_->snapshot_;
+}
+
+/* Stop the run after the block being evaluated */
+void MorrisRun::cancel()
+{
+  if (!state_.isNull()) state_->cancelled_ = true;
+}
+
+/* Status accessors */
+Bool MorrisRun::isDone() const
+{
+  return state_.isNull() || state_->done_;
+}
+
+Bool MorrisRun::isCancelled() const
+{
+  return !state_.isNull() && state_->stoppedEarly_;
+}
+
+/* Wait for the end of the run */
+void MorrisRun::wait() const
+{
+  if (!state_.isNull()) state_->future_.wait();
+}
+
+/* Final result, partial if the run was cancelled */
+Morris MorrisRun::getResult() const
+{
+  if (state_.isNull())
+    throw NotDefinedException(HERE) << "In MorrisRun::getResult, no run";
+  return state_->future_.get();
+}
+
+/* Future of the final result */
+std::shared_future<Morris> MorrisRun::getFuture() const
+{
+  if (state_.isNull())
+    throw NotDefinedException(HERE) << "In MorrisRun::getFuture, no run";
+  return state_->future_;
+}
+
+/* String converter */
+String MorrisRun::__repr__() const
+{
+  OSS oss;
+  oss << "class=" << MorrisRun::GetClassName()
+      << ", evaluations=" << getEvaluationNumber()
+      << "/" << getTotalEvaluationNumber()
+      << ", done=" << isDone()
+      << ", cancelled=" << isCancelled();
+  return oss;
+}
+
+} /* namespace OTMORRIS */
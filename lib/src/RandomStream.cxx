@@ -0,0 +1,113 @@
+//                                               -*- C++ -*-
+/**
+ *  @brief RandomStream
+ *
+ *  Copyright 2005-2018 Airbus-EDF-IMACS-Phimeca
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License.
+ *
+ *  This library is distributed in the hope that it will be useful
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+ *
+ */
+#include "otmorris/RandomStream.hxx"
+#include <openturns/Exception.hxx>
+#include <utility>
+
+using namespace OT;
+
+namespace OTMORRIS
+{
+
+/* splitmix64 finalizer */
+static std::uint64_t Mix(std::uint64_t z)
+{
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+/* Constructor */
+RandomStream::RandomStream(const UnsignedInteger seed, const UnsignedInteger stream)
+  : state_(Mix(static_cast<std::uint64_t>(seed) + 0x9e3779b97f4a7c15ULL) ^ Mix(static_cast<std::uint64_t>(stream) * 0xd1b54a32d192ed03ULL + 1))
+{
+  // Nothing to do
+}
+
+std::uint64_t RandomStream::next()
+{
+  state_ += 0x9e3779b97f4a7c15ULL;
+  return Mix(state_);
+}
+
+/* Uniform integer in [0, n) */
+UnsignedInteger RandomStream::integerGenerate(const UnsignedInteger n)
+{
+  if (n == 0)
+    throw InvalidArgumentException(HERE) << "In RandomStream::integerGenerate, n should be positive";
+  // Rejection to avoid the modulo bias
+  const std::uint64_t bound = static_cast<std::uint64_t>(n);
+  const std::uint64_t threshold = (0 - bound) % bound;
+  std::uint64_t value = next();
+  while (value < threshold) value = next();
+  return static_cast<UnsignedInteger>(value % bound);
+}
+
+/* Uniform real in [0, 1) */
+Scalar RandomStream::generate()
+{
+  return static_cast<Scalar>(next() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/* Uniform random permutation of [0, n) */
+Indices RandomStream::permutation(const UnsignedInteger n)
+{
+  Indices result(n);
+  result.fill();
+  // Fisher-Yates shuffle
+  for (UnsignedInteger i = n; i > 1; --i)
+    std::swap(result[i - 1], result[integerGenerate(i)]);
+  return result;
+}
+
+/* Pseudo-random bijection of [0, size) keyed by key, evaluated at index */
+UnsignedInteger RandomStream::Permute(const UnsignedInteger index, const UnsignedInteger size, const UnsignedInteger key)
+{
+  if (index >= size)
+    throw InvalidArgumentException(HERE) << "In RandomStream::Permute, index=" << index << " should be lesser than size=" << size;
+  if (static_cast<std::uint64_t>(size) > (static_cast<std::uint64_t>(1) << 62))
+    throw InvalidArgumentException(HERE) << "In RandomStream::Permute, size=" << size << " should not exceed 2^62";
+  // Balanced Feistel network on 2 * halfBits bits, with 2^(2 * halfBits) < 4 * size
+  UnsignedInteger halfBits = 1;
+  while ((static_cast<std::uint64_t>(1) << (2 * halfBits)) < static_cast<std::uint64_t>(size)) ++halfBits;
+  const std::uint64_t mask = (static_cast<std::uint64_t>(1) << halfBits) - 1;
+  const std::uint64_t k = Mix(static_cast<std::uint64_t>(key) ^ 0x5851f42d4c957f2dULL);
+  // Cycle walking: iterate until the image falls into [0, size)
+  std::uint64_t value = index;
+  do
+  {
+    std::uint64_t left = value >> halfBits;
+    std::uint64_t right = value & mask;
+    for (std::uint64_t round = 0; round < 4; ++round)
+    {
+      const std::uint64_t f = Mix(right ^ (k + round * 0x9e3779b97f4a7c15ULL)) & mask;
+      const std::uint64_t newRight = left ^ f;
+      left = right;
+      right = newRight;
+    }
+    value = (left << halfBits) | right;
+  }
+  while (value >= static_cast<std::uint64_t>(size));
+  return static_cast<UnsignedInteger>(value);
+}
+
+} /* namespace OTMORRIS */
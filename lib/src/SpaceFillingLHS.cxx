@@ -0,0 +1,367 @@
+//                                               -*- C++ -*-
+/**
+ *  @brief SpaceFillingLHS
+ *
+ *  Copyright 2005-2018 Airbus-EDF-IMACS-Phimeca
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License.
+ *
+ *  This library is distributed in the hope that it will be useful
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+ *
+ */
+#include "otmorris/SpaceFillingLHS.hxx"
+#include "otmorris/RandomStream.hxx"
+#include <openturns/Exception.hxx>
+#include <openturns/Log.hxx>
+#include <openturns/SpecFunc.hxx>
+#include <openturns/Collection.hxx>
+#include <openturns/TBBImplementation.hxx>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace OT;
+
+namespace OTMORRIS
+{
+
+// Exponent of the phi_p smoothing of the maximin criterion
+static const Scalar PhiPExponent = 50.0;
+
+/* Scaled squared distance to the power -PhiPExponent/2, without calling pow */
+static inline Scalar PhiPTerm(const Scalar squaredDistance)
+{
+  const Scalar r = 1.0 / squaredDistance;
+  const Scalar r2 = r * r;
+  const Scalar r4 = r2 * r2;
+  const Scalar r8 = r4 * r4;
+  return r8 * r8 * r8 * r;
+}
+
+// Geometric cooling of the relative temperature
+static const Scalar InitialTemperature = 1.0e-2;
+static const Scalar FinalTemperature = 1.0e-5;
+
+const UnsignedInteger SpaceFillingLHS::MaximumCachedSize = 2000;
+
+/* Centered L2 discrepancy factors */
+static inline Scalar RowFactor(const Scalar z)
+{
+  return 1.0 + 0.5 * std::abs(z) - 0.5 * z * z;
+}
+
+static inline Scalar PairFactor(const Scalar zi, const Scalar zj)
+{
+  return 1.0 + 0.5 * std::abs(zi) + 0.5 * std::abs(zj) - 0.5 * std::abs(zi - zj);
+}
+
+/* Constructor */
+SpaceFillingLHS::SpaceFillingLHS(const UnsignedInteger size, const UnsignedInteger dimension, const String & criterion)
+  : size_(size)
+  , dimension_(dimension)
+  , criterion_(criterion)
+  , startNumber_(4)
+  , iterationNumber_(std::max<UnsignedInteger>(10000, 50 * size))
+{
+  if ((criterion != "maximin") && (criterion != "C2"))
+    throw InvalidArgumentException(HERE) << "In SpaceFillingLHS, criterion should be maximin or C2, here criterion=" << criterion;
+  if ((size == 0) || (dimension == 0))
+    throw InvalidArgumentException(HERE) << "In SpaceFillingLHS, size and dimension should be positive";
+}
+
+/* Number of independent starts accessor */
+void SpaceFillingLHS::setStartNumber(const UnsignedInteger startNumber)
+{
+  if (startNumber == 0)
+    throw InvalidArgumentException(HERE) << "In SpaceFillingLHS, the number of starts should be positive";
+  startNumber_ = startNumber;
+}
+
+/* Number of swaps per start accessor */
+void SpaceFillingLHS::setIterationNumber(const UnsignedInteger iterationNumber)
+{
+  iterationNumber_ = iterationNumber;
+}
+
+/* Criterion of a design of [0,1]^d, the lower the better */
+Scalar SpaceFillingLHS::computeCriterion(const Sample & design) const
+{
+  const UnsignedInteger n = design.getSize();
+  const UnsignedInteger d = design.getDimension();
+  if (criterion_ == "maximin")
+  {
+    // phi_p = (sum_{i<j} dist_ij^-p)^(1/p), computed relatively to the smallest distance
+    Scalar minimumSquaredDistance = SpecFunc::MaxScalar;
+    Point squaredDistances(n * (n - 1) / 2);
+    UnsignedInteger index = 0;
+    for (UnsignedInteger i = 0; i < n; ++i)
+      for (UnsignedInteger j = 0; j < i; ++j, ++index)
+      {
+        Scalar squaredDistance = 0.0;
+        for (UnsignedInteger k = 0; k < d; ++k)
+        {
+          const Scalar delta = design(i, k) - design(j, k);
+          squaredDistance += delta * delta;
+        }
+        squaredDistances[index] = squaredDistance;
+        minimumSquaredDistance = std::min(minimumSquaredDistance, squaredDistance);
+      }
+    if (index == 0) return 0.0;
+    if (!(minimumSquaredDistance > 0.0)) return SpecFunc::MaxScalar;
+    Scalar sum = 0.0;
+    for (UnsignedInteger i = 0; i < index; ++i)
+      sum += PhiPTerm(squaredDistances[i] / minimumSquaredDistance);
+    return std::pow(sum, 1.0 / PhiPExponent) / std::sqrt(minimumSquaredDistance);
+  }
+  // Centered L2 discrepancy, with z = x - 1/2
+  Scalar rowSum = 0.0;
+  Scalar pairSum = 0.0;
+  for (UnsignedInteger i = 0; i < n; ++i)
+  {
+    Scalar rowTerm = 1.0;
+    for (UnsignedInteger k = 0; k < d; ++k) rowTerm *= RowFactor(design(i, k) - 0.5);
+    rowSum += rowTerm;
+    for (UnsignedInteger j = 0; j <= i; ++j)
+    {
+      Scalar pairTerm = 1.0;
+      for (UnsignedInteger k = 0; k < d; ++k) pairTerm *= PairFactor(design(i, k) - 0.5, design(j, k) - 0.5);
+      pairSum += (j < i ? 2.0 : 1.0) * pairTerm;
+    }
+  }
+  const Scalar squaredDiscrepancy = std::pow(13.0 / 12.0, 1.0 * d) - 2.0 * rowSum / n + pairSum / (1.0 * n * n);
+  return std::sqrt(std::max(0.0, squaredDiscrepancy));
+}
+
+/* Optimize from the start-th random design; levels are column-major */
+Scalar SpaceFillingLHS::optimize(const UnsignedInteger seed, const UnsignedInteger start, Indices & levels) const
+{
+  const UnsignedInteger n = size_;
+  const UnsignedInteger d = dimension_;
+  RandomStream stream(seed, start);
+  levels = Indices(n * d);
+  for (UnsignedInteger k = 0; k < d; ++k)
+  {
+    const Indices permutation(stream.permutation(n));
+    std::copy(permutation.begin(), permutation.end(), levels.begin() + k * n);
+  }
+  // Centered coordinates, z = x - 1/2 for the discrepancy
+  std::vector<Scalar> z(n * d);
+  for (UnsignedInteger i = 0; i < n * d; ++i) z[i] = (levels[i] + 0.5) / n - 0.5;
+  const Bool maximin = (criterion_ == "maximin");
+  // Squared distances are scaled so that the smallest possible one is 1
+  const Scalar scale = (1.0 * n * n) / d;
+
+  // Pairwise terms: scaled squared distances (maximin) or discrepancy products (C2)
+  const Bool cached = (n <= MaximumCachedSize);
+  std::vector<Scalar> pair(cached ? n * n : 0);
+  std::vector<Scalar> rowTerm(maximin ? 0 : n);
+  // Exact pairwise term of rows i and j from the coordinates
+  struct PairTerm
+  {
+    const std::vector<Scalar> & z_;
+    UnsignedInteger n_;
+    UnsignedInteger d_;
+    Bool maximin_;
+    Scalar scale_;
+    Scalar operator()(const UnsignedInteger i, const UnsignedInteger j) const
+    {
+      Scalar value = (maximin_ ? 0.0 : 1.0);
+      for (UnsignedInteger k = 0; k < d_; ++k)
+      {
+        const Scalar zi = z_[k * n_ + i];
+        const Scalar zj = z_[k * n_ + j];
+        if (maximin_) value += (zi - zj) * (zi - zj);
+        else value *= PairFactor(zi, zj);
+      }
+      return (maximin_ ? value * scale_ : value);
+    }
+  } pairTerm = {z, n, d, maximin, scale};
+
+  // Criterion sums: sum_{i<j} D_ij^-q (maximin), sum_i r_i and sum_ij c_ij (C2)
+  Scalar sum = 0.0;
+  Scalar rowSum = 0.0;
+  for (UnsignedInteger i = 0; i < n; ++i)
+  {
+    if (!maximin)
+    {
+      rowTerm[i] = 1.0;
+      for (UnsignedInteger k = 0; k < d; ++k) rowTerm[i] *= RowFactor(z[k * n + i]);
+      rowSum += rowTerm[i];
+    }
+    // The diagonal only matters for the discrepancy
+    for (UnsignedInteger j = 0; j <= i; ++j)
+    {
+      if (maximin && (j == i)) continue;
+      const Scalar value = pairTerm(i, j);
+      if (cached)
+      {
+        pair[i * n + j] = value;
+        pair[j * n + i] = value;
+      }
+      if (maximin) sum += PhiPTerm(value);
+      else sum += (j < i ? 2.0 : 1.0) * value;
+    }
+  }
+  const Scalar cubeTerm = std::pow(13.0 / 12.0, 1.0 * d);
+  // Value of the criterion from the sums
+  struct CriterionValue
+  {
+    Bool maximin_;
+    Scalar cubeTerm_;
+    Scalar n_;
+    Scalar operator()(const Scalar sum, const Scalar rowSum) const
+    {
+      if (maximin_) return std::pow(std::max(sum, 0.0), 1.0 / PhiPExponent);
+      return std::sqrt(std::max(0.0, cubeTerm_ - 2.0 * rowSum / n_ + sum / (n_ * n_)));
+    }
+  } criterionValue = {maximin, cubeTerm, 1.0 * n};
+  Scalar current = criterionValue(sum, rowSum);
+
+  std::vector<Scalar> newPairA(n);
+  std::vector<Scalar> newPairB(n);
+  const Scalar cooling = (iterationNumber_ > 1 ? std::pow(FinalTemperature / InitialTemperature, 1.0 / (iterationNumber_ - 1)) : 1.0);
+  Scalar temperature = InitialTemperature;
+  UnsignedInteger acceptedNumber = 0;
+  for (UnsignedInteger iteration = 0; (iteration < iterationNumber_) && (n > 1) && (current > 0.0); ++iteration, temperature *= cooling)
+  {
+    // Swap the levels of rows a and b in column k
+    const UnsignedInteger k = stream.integerGenerate(d);
+    const UnsignedInteger a = stream.integerGenerate(n);
+    UnsignedInteger b = stream.integerGenerate(n - 1);
+    if (b >= a) ++b;
+    const Scalar * zk = &z[k * n];
+    const Scalar za = zk[a];
+    const Scalar zb = zk[b];
+    // Only the terms of pairs (a, j) and (b, j) change, j != a, b
+    Scalar delta = 0.0;
+    Scalar newRowA = 0.0;
+    Scalar newRowB = 0.0;
+    for (UnsignedInteger j = 0; j < n; ++j)
+    {
+      if ((j == a) || (j == b)) continue;
+      const Scalar zj = zk[j];
+      const Scalar oldA = (cached ? pair[a * n + j] : pairTerm(a, j));
+      const Scalar oldB = (cached ? pair[b * n + j] : pairTerm(b, j));
+      if (maximin)
+      {
+        const Scalar shift = scale * ((zb - zj) * (zb - zj) - (za - zj) * (za - zj));
+        newPairA[j] = oldA + shift;
+        newPairB[j] = oldB - shift;
+        delta += PhiPTerm(newPairA[j]) + PhiPTerm(newPairB[j]) - PhiPTerm(oldA) - PhiPTerm(oldB);
+      }
+      else
+      {
+        newPairA[j] = oldA / PairFactor(za, zj) * PairFactor(zb, zj);
+        newPairB[j] = oldB / PairFactor(zb, zj) * PairFactor(za, zj);
+        delta += 2.0 * (newPairA[j] + newPairB[j] - oldA - oldB);
+      }
+    }
+    Scalar rowDelta = 0.0;
+    Scalar newPairAA = 0.0;
+    Scalar newPairBB = 0.0;
+    if (!maximin)
+    {
+      // Row terms and diagonal pair terms c_ii = prod (1 + |z_ik|)
+      newRowA = rowTerm[a] / RowFactor(za) * RowFactor(zb);
+      newRowB = rowTerm[b] / RowFactor(zb) * RowFactor(za);
+      rowDelta = newRowA + newRowB - rowTerm[a] - rowTerm[b];
+      const Scalar oldPairAA = (cached ? pair[a * n + a] : pairTerm(a, a));
+      const Scalar oldPairBB = (cached ? pair[b * n + b] : pairTerm(b, b));
+      newPairAA = oldPairAA / (1.0 + std::abs(za)) * (1.0 + std::abs(zb));
+      newPairBB = oldPairBB / (1.0 + std::abs(zb)) * (1.0 + std::abs(za));
+      delta += newPairAA + newPairBB - oldPairAA - oldPairBB;
+    }
+    const Scalar candidate = criterionValue(sum + delta, rowSum + rowDelta);
+    const Scalar relativeChange = (candidate - current) / current;
+    if ((relativeChange > 0.0) && !(stream.generate() < std::exp(-relativeChange / temperature))) continue;
+    // Accept the swap
+    ++ acceptedNumber;
+    std::swap(levels[k * n + a], levels[k * n + b]);
+    z[k * n + a] = zb;
+    z[k * n + b] = za;
+    sum += delta;
+    rowSum += rowDelta;
+    current = candidate;
+    if (!maximin)
+    {
+      rowTerm[a] = newRowA;
+      rowTerm[b] = newRowB;
+    }
+    if (cached)
+    {
+      for (UnsignedInteger j = 0; j < n; ++j)
+      {
+        if ((j == a) || (j == b)) continue;
+        pair[a * n + j] = newPairA[j];
+        pair[j * n + a] = newPairA[j];
+        pair[b * n + j] = newPairB[j];
+        pair[j * n + b] = newPairB[j];
+      }
+      if (!maximin)
+      {
+        pair[a * n + a] = newPairAA;
+        pair[b * n + b] = newPairBB;
+      }
+    }
+  }
+  LOGINFO(OSS() << "SpaceFillingLHS start " << start << ": " << acceptedNumber << " accepted swaps over " << iterationNumber_);
+  // Exact criterion of the final design, free from the accumulated rounding errors
+  Sample design(n, d);
+  for (UnsignedInteger i = 0; i < n; ++i)
+    for (UnsignedInteger k = 0; k < d; ++k)
+      design(i, k) = (levels[k * n + i] + 0.5) / n;
+  return computeCriterion(design);
+}
+
+/* Parallel independent starts */
+struct SpaceFillingLHSPolicy
+{
+  const SpaceFillingLHS & lhs_;
+  const UnsignedInteger seed_;
+  Collection<Indices> & levels_;
+  Point & criteria_;
+
+  SpaceFillingLHSPolicy(const SpaceFillingLHS & lhs, const UnsignedInteger seed, Collection<Indices> & levels, Point & criteria)
+    : lhs_(lhs)
+    , seed_(seed)
+    , levels_(levels)
+    , criteria_(criteria)
+  {}
+
+  inline void operator()(const TBBImplementation::BlockedRange<UnsignedInteger> & r) const
+  {
+    for (UnsignedInteger start = r.begin(); start != r.end(); ++start)
+      criteria_[start] = lhs_.optimize(seed_, start, levels_[start]);
+  }
+}; /* end struct SpaceFillingLHSPolicy */
+
+/* Best design over the starts, fully determined by the seed */
+Sample SpaceFillingLHS::generate(const UnsignedInteger seed) const
+{
+  Collection<Indices> levels(startNumber_);
+  Point criteria(startNumber_);
+  const SpaceFillingLHSPolicy policy(*this, seed, levels, criteria);
+  TBBImplementation::ParallelFor(0, startNumber_, policy);
+  // Ties are broken by the start index, so that the result does not depend on the scheduling
+  UnsignedInteger best = 0;
+  for (UnsignedInteger start = 1; start < startNumber_; ++start)
+    if (criteria[start] < criteria[best]) best = start;
+  LOGINFO(OSS() << "SpaceFillingLHS " << criterion_ << " criterion=" << criteria[best] << " (start " << best << " over " << startNumber_ << ")");
+  Sample design(size_, dimension_);
+  for (UnsignedInteger i = 0; i < size_; ++i)
+    for (UnsignedInteger k = 0; k < dimension_; ++k)
+      design(i, k) = (levels[best][k * size_ + i] + 0.5) / size_;
+  return design;
+}
+
+} /* namespace OTMORRIS */
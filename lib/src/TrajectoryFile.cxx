@@ -0,0 +1,360 @@
+//                                               -*- C++ -*-
+/**
+ *  @brief TrajectoryFile
+ *
+ *  Copyright 2005-2018 Airbus-EDF-IMACS-Phimeca
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License.
+ *
+ *  This library is distributed in the hope that it will be useful
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+ *
+ */
+#include "otmorris/TrajectoryFile.hxx"
+#include <openturns/Exception.hxx>
+#include <openturns/Log.hxx>
+#include <openturns/ResourceMap.hxx>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+
+using namespace OT;
+
+namespace OTMORRIS
+{
+
+CLASSNAMEINIT(TrajectoryFile)
+
+// Size of the reserved .npy header, so that it can be rewritten in place on close
+static const UnsignedInteger NumpyHeaderSize = 128;
+
+// Index layout: magic, format, dimension, separator, trajectory number, offsets
+static const char IndexMagic[8] = {'O', 'T', 'M', 'I', 'D', 'X', '0', '1'};
+static const UnsignedInteger IndexHeaderSize = sizeof(IndexMagic) + 4 * sizeof(std::uint64_t);
+
+enum TrajectoryFileFormat {RAW = 0, NPY = 1, CSV = 2, RAW32 = 3, NPY32 = 4};
+
+/**
+ * Stream of a TrajectoryFile and offsets of its trajectories, shared by its copies.
+ * The file is finalized by close(), or when the last copy is destroyed.
+ */
+class TrajectoryWriter
+{
+public:
+  TrajectoryWriter(const FileName & fileName, const UnsignedInteger dimension, const String & format)
+    : fileName_(fileName)
+    , format_(format)
+    , dimension_(dimension)
+    , stream_(fileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc)
+    , offsets_()
+    , rowNumber_(0)
+  {
+    if (!stream_)
+      throw FileOpenException(HERE) << "Cannot open file " << fileName << " for writing";
+    if ((format_ == "npy") || (format_ == "npy32"))
+      writeNumpyHeader(0);
+    else if (format_ == "csv")
+      stream_ << std::setprecision(17);
+  }
+
+  ~TrajectoryWriter()
+  {
+    // Files left open, eg by an exception, are still readable
+    try
+    {
+      close();
+    }
+    catch (...)
+    {
+      LOGWARN(OSS() << "In TrajectoryFile, could not finalize file " << fileName_);
+    }
+  }
+
+  /** Whether values are stored as float32 */
+  Bool isSinglePrecision() const
+  {
+    return (format_ == "npy32") || (format_ == "raw32");
+  }
+
+  /** Write the .npy header for the given number of rows */
+  void writeNumpyHeader(const UnsignedInteger rowNumber)
+  {
+    OSS dictionary;
+    dictionary << "{'descr': '" << (isSinglePrecision() ? "<f4" : "<f8") << "', 'fortran_order': False, 'shape': (" << rowNumber << ", " << dimension_ << "), }";
+    String header(dictionary);
+    // Pad with spaces up to the reserved size, the header ends with a newline
+    header.resize(NumpyHeaderSize - 10 - 1, ' ');
+    header += '\n';
+    const UnsignedInteger headerLength = header.size();
+    stream_.seekp(0);
+    stream_.write("\x93NUMPY\x01\x00", 8);
+    const char length[2] = {static_cast<char>(headerLength % 256), static_cast<char>(headerLength / 256)};
+    stream_.write(length, 2);
+    stream_.write(header.c_str(), headerLength);
+  }
+
+  /** Append one trajectory */
+  void add(const Sample & trajectory)
+  {
+    if (!stream_.is_open())
+      throw InternalException(HERE) << "In TrajectoryFile::add, file " << fileName_ << " is closed";
+    offsets_.add(static_cast<UnsignedInteger>(stream_.tellp()));
+    const UnsignedInteger size = trajectory.getSize();
+    if (format_ == "csv")
+    {
+      const String separator(ResourceMap::GetAsString("csv-file-separator"));
+      for (UnsignedInteger i = 0; i < size; ++i)
+      {
+        for (UnsignedInteger j = 0; j < dimension_; ++j)
+        {
+          if (j > 0) stream_ << separator;
+          stream_ << trajectory(i, j);
+        }
+        stream_ << "\n";
+      }
+    }
+    else if (isSinglePrecision())
+    {
+      // Data are written row-major, rounded to native floats
+      std::vector<float> row(dimension_);
+      for (UnsignedInteger i = 0; i < size; ++i)
+      {
+        for (UnsignedInteger j = 0; j < dimension_; ++j) row[j] = static_cast<float>(trajectory(i, j));
+        stream_.write(reinterpret_cast<const char *>(&row[0]), dimension_ * sizeof(float));
+      }
+    }
+    else
+    {
+      // Data are written row-major, as native doubles
+      Point row(dimension_);
+      for (UnsignedInteger i = 0; i < size; ++i)
+      {
+        for (UnsignedInteger j = 0; j < dimension_; ++j) row[j] = trajectory(i, j);
+        stream_.write(reinterpret_cast<const char *>(&row[0]), dimension_ * sizeof(Scalar));
+      }
+    }
+    rowNumber_ += size;
+    if (!stream_)
+      throw FileOpenException(HERE) << "Error while writing into file " << fileName_;
+  }
+
+  /** Finalize the file header and write the index */
+  void close()
+  {
+    if (!stream_.is_open()) return;
+    const UnsignedInteger end = static_cast<UnsignedInteger>(stream_.tellp());
+    if ((format_ == "npy") || (format_ == "npy32"))
+      writeNumpyHeader(rowNumber_);
+    stream_.close();
+
+    const FileName indexFileName(fileName_ + ".index");
+    std::ofstream index(indexFileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!index)
+      throw FileOpenException(HERE) << "Cannot open file " << indexFileName << " for writing";
+    TrajectoryFileFormat format = RAW;
+    if (format_ == "npy") format = NPY;
+    else if (format_ == "csv") format = CSV;
+    else if (format_ == "raw32") format = RAW32;
+    else if (format_ == "npy32") format = NPY32;
+    const String separator(ResourceMap::GetAsString("csv-file-separator"));
+    const std::uint64_t header[4] = {static_cast<std::uint64_t>(format), static_cast<std::uint64_t>(dimension_),
+                                     static_cast<std::uint64_t>(separator[0]), static_cast<std::uint64_t>(offsets_.getSize())
+                                    };
+    index.write(IndexMagic, sizeof(IndexMagic));
+    index.write(reinterpret_cast<const char *>(header), sizeof(header));
+    for (UnsignedInteger k = 0; k <= offsets_.getSize(); ++k)
+    {
+      const std::uint64_t offset = (k < offsets_.getSize() ? offsets_[k] : end);
+      index.write(reinterpret_cast<const char *>(&offset), sizeof(offset));
+    }
+    if (!index)
+      throw FileOpenException(HERE) << "Error while writing into file " << indexFileName;
+    LOGINFO(OSS() << "Wrote " << offsets_.getSize() << " trajectories into " << fileName_);
+  }
+
+  /** Number of trajectories written so far */
+  UnsignedInteger getTrajectoryNumber() const
+  {
+    return offsets_.getSize();
+  }
+
+private:
+  TrajectoryWriter(const TrajectoryWriter &);
+  TrajectoryWriter & operator=(const TrajectoryWriter &);
+
+  FileName fileName_;
+  String format_;
+  UnsignedInteger dimension_;
+  std::ofstream stream_;
+
+  // Byte offset of each trajectory
+  Collection<UnsignedInteger> offsets_;
+
+  UnsignedInteger rowNumber_;
+
+}; /* class TrajectoryWriter */
+
+/* Default constructor */
+TrajectoryFile::TrajectoryFile()
+  : Object()
+  , fileName_()
+  , format_()
+  , dimension_(0)
+  , writer_()
+{
+  // Nothing to do
+}
+
+/* Constructor */
+TrajectoryFile::TrajectoryFile(const FileName & fileName, const UnsignedInteger dimension, const String & format)
+  : Object()
+  , fileName_(fileName)
+  , format_(format)
+  , dimension_(dimension)
+  , writer_()
+{
+  if ((format != "npy") && (format != "raw") && (format != "npy32") && (format != "raw32") && (format != "csv"))
+    throw InvalidArgumentException(HERE) << "In TrajectoryFile::TrajectoryFile, format should be npy, raw, npy32, raw32 or csv, here format=" << format;
+  if (dimension == 0)
+    throw InvalidArgumentException(HERE) << "In TrajectoryFile::TrajectoryFile, dimension should be positive";
+  writer_ = Pointer<TrajectoryWriter>(new TrajectoryWriter(fileName, dimension, format));
+}
+
+/* Append one trajectory */
+void TrajectoryFile::add(const Sample & trajectory)
+{
+  if (writer_.isNull())
+    throw InternalException(HERE) << "In TrajectoryFile::add, no file is open";
+  if (trajectory.getDimension() != dimension_)
+    throw InvalidDimensionException(HERE) << "In TrajectoryFile::add, expected a trajectory of dimension " << dimension_
+                                          << ", here dimension=" << trajectory.getDimension();
+  writer_->add(trajectory);
+}
+
+/* Finalize the file header and write the index */
+void TrajectoryFile::close()
+{
+  if (writer_.isNull()) return;
+  writer_->close();
+}
+
+/* Number of trajectories written so far */
+UnsignedInteger TrajectoryFile::getTrajectoryNumber() const
+{
+  return (writer_.isNull() ? 0 : writer_->getTrajectoryNumber());
+}
+
+/* File name accessors */
+FileName TrajectoryFile::getFileName() const
+{
+  return fileName_;
+}
+
+FileName TrajectoryFile::getIndexFileName() const
+{
+  return fileName_ + ".index";
+}
+
+/* Read count trajectories starting from first using the index */
+Sample TrajectoryFile::Read(const FileName & fileName, const UnsignedInteger first, const UnsignedInteger count)
+{
+  const FileName indexFileName(fileName + ".index");
+  std::ifstream index(indexFileName.c_str(), std::ios::in | std::ios::binary);
+  if (!index)
+    throw FileOpenException(HERE) << "Cannot open index file " << indexFileName;
+  char magic[sizeof(IndexMagic)];
+  std::uint64_t header[4];
+  index.read(magic, sizeof(magic));
+  index.read(reinterpret_cast<char *>(header), sizeof(header));
+  if (!index || (std::memcmp(magic, IndexMagic, sizeof(IndexMagic)) != 0))
+    throw FileNotFoundException(HERE) << "File " << indexFileName << " is not a trajectory index";
+  const UnsignedInteger format = header[0];
+  const UnsignedInteger dimension = header[1];
+  const char separator = static_cast<char>(header[2]);
+  const UnsignedInteger trajectoryNumber = header[3];
+  if (first + count > trajectoryNumber)
+    throw OutOfBoundException(HERE) << "In TrajectoryFile::Read, trajectories [" << first << ", " << first + count
+                                    << ") exceed the number of trajectories=" << trajectoryNumber;
+  // Only the two bounding offsets are needed
+  std::uint64_t begin = 0;
+  std::uint64_t end = 0;
+  index.seekg(IndexHeaderSize + first * sizeof(std::uint64_t));
+  index.read(reinterpret_cast<char *>(&begin), sizeof(begin));
+  index.seekg(IndexHeaderSize + (first + count) * sizeof(std::uint64_t));
+  index.read(reinterpret_cast<char *>(&end), sizeof(end));
+  if (!index)
+    throw FileNotFoundException(HERE) << "Truncated index file " << indexFileName;
+
+  std::ifstream data(fileName.c_str(), std::ios::in | std::ios::binary);
+  if (!data)
+    throw FileOpenException(HERE) << "Cannot open file " << fileName;
+  data.seekg(begin);
+  String buffer(end - begin, ' ');
+  if (end > begin) data.read(&buffer[0], end - begin);
+  if (!data)
+    throw FileNotFoundException(HERE) << "Truncated file " << fileName;
+
+  if ((format == RAW32) || (format == NPY32))
+  {
+    const UnsignedInteger size = (end - begin) / (dimension * sizeof(float));
+    Sample sample(size, dimension);
+    const float * values = reinterpret_cast<const float *>(buffer.c_str());
+    for (UnsignedInteger i = 0; i < size; ++i)
+      for (UnsignedInteger j = 0; j < dimension; ++j)
+        sample(i, j) = values[i * dimension + j];
+    return sample;
+  }
+  if (format != CSV)
+  {
+    const UnsignedInteger size = (end - begin) / (dimension * sizeof(Scalar));
+    Sample sample(size, dimension);
+    const Scalar * values = reinterpret_cast<const Scalar *>(buffer.c_str());
+    for (UnsignedInteger i = 0; i < size; ++i)
+      for (UnsignedInteger j = 0; j < dimension; ++j)
+        sample(i, j) = values[i * dimension + j];
+    return sample;
+  }
+  Sample sample(0, dimension);
+  Point row(dimension);
+  const char * cursor = buffer.c_str();
+  const char * last = cursor + buffer.size();
+  while (cursor < last)
+  {
+    for (UnsignedInteger j = 0; j < dimension; ++j)
+    {
+      char * next = 0;
+      row[j] = std::strtod(cursor, &next);
+      if ((next == cursor) || ((j + 1 < dimension) && (*next != separator)))
+        throw FileNotFoundException(HERE) << "In TrajectoryFile::Read, malformed line in file " << fileName;
+      cursor = next + 1;
+    }
+    sample.add(row);
+  }
+  return sample;
+}
+
+/* String converter */
+String TrajectoryFile::__repr__() const
+{
+  OSS oss;
+  oss << "class=" << TrajectoryFile::GetClassName()
+      << ", file name=" << fileName_
+      << ", format=" << format_
+      << ", dimension=" << dimension_
+      << ", trajectories=" << getTrajectoryNumber();
+  return oss;
+}
+
+} /* namespace OTMORRIS */
@@ -0,0 +1,105 @@
+//                                               -*- C++ -*-
+/**
+ *  @brief MemoryMappedSample gives read-only access to a sample stored
+ *  in a binary file without loading it in memory
+ *
+ *  Copyright 2005-2018 Airbus-EDF-IMACS-Phimeca
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License.
+ *
+ *  This library is distributed in the hope that it will be useful
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+ *
+ */
+#ifndef OTMORRIS_MEMORYMAPPEDSAMPLE_HXX
+#define OTMORRIS_MEMORYMAPPEDSAMPLE_HXX
+
+#include <openturns/Object.hxx>
+#include <openturns/Pointer.hxx>
+#include <openturns/Sample.hxx>
+#include "otmorris/OTMORRISprivate.hxx"
+
+namespace OTMORRIS
+{
+
+class MappedRegion;
+
+/**
+ * @class MemoryMappedSample
+ *
+ * MemoryMappedSample maps a row-major binary file of doubles or floats
+ * (either raw or in the numpy .npy format) so that rows can be read
+ * directly from the mapped pages
+ */
+class OTMORRIS_API MemoryMappedSample
+  : public OT::Object
+{
+  CLASSNAME
+
+public:
+  /** Default constructor */
+  MemoryMappedSample();
+
+  /** Constructor from a raw row-major file of doubles, or of floats if singlePrecision is true */
+  MemoryMappedSample(const OT::FileName & fileName, const OT::UnsignedInteger dimension, const OT::Bool singlePrecision = false);
+
+  /** Constructor from a .npy file */
+  explicit MemoryMappedSample(const OT::FileName & fileName);
+
+  /** Size/dimension accessors */
+  OT::UnsignedInteger getSize() const;
+  OT::UnsignedInteger getDimension() const;
+
+  /** File name accessor */
+  OT::FileName getFileName() const;
+
+  /** Whether the file holds floats */
+  OT::Bool isSinglePrecision() const;
+
+  /** Raw accessors to the row-major mapped data, of doubles or floats */
+  const OT::Scalar * data() const;
+  const float * singlePrecisionData() const;
+
+  /** Copy size consecutive rows starting from first into a Sample */
+  OT::Sample getSample(const OT::UnsignedInteger first, const OT::UnsignedInteger size) const;
+
+  /** String converter */
+  OT::String __repr__() const override;
+
+private:
+  /** Map the file and check its size against the header */
+  void map(const OT::UnsignedInteger offset);
+
+  /** Parse the header of a .npy file, returns the offset of the data */
+  OT::UnsignedInteger parseNumpyHeader();
+
+  // Underlying file
+  OT::FileName fileName_;
+
+  // Shared mapping, released when the last copy is destroyed
+  OT::Pointer<MappedRegion> region_;
+
+  // Number of rows/columns
+  OT::UnsignedInteger size_;
+  OT::UnsignedInteger dimension_;
+
+  // Whether values are floats
+  OT::Bool singlePrecision_;
+
+  // First value of the data
+  const char * data_;
+
+}; /* class MemoryMappedSample */
+
+} /* namespace OTMORRIS */
+
+#endif /* OTMORRIS_MEMORYMAPPEDSAMPLE_HXX */
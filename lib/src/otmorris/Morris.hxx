@@ -25,35 +25,118 @@
 #include <openturns/TypedInterfaceObject.hxx>
 #include <openturns/StorageManager.hxx>
 #include <openturns/Function.hxx>
+#include <openturns/Collection.hxx>
+#include <openturns/Distribution.hxx>
+#include <openturns/Pointer.hxx>
+#include <iosfwd>
+#include <map>
+#include <vector>
 #include "otmorris/OTMORRISprivate.hxx"
 #include "otmorris/MorrisExperiment.hxx"
+#include "otmorris/MemoryMappedSample.hxx"
 
 namespace OTMORRIS
 {
 
+class MorrisRegionalAnalysis;
+class MorrisRunState;
+
 class OTMORRIS_API Morris
   : public OT::PersistentObject
 {
   CLASSNAME
+  friend class MorrisRegionalAnalysis;
+  friend class MorrisRunState;
 
 public:
+  typedef OT::Collection<OT::Function> FunctionCollection;
+
   /** Default constructor for save/load mechanism */
   Morris();
 
   /** Standard constructor with in/out designs */
   Morris(const OT::Sample & inputSample, const OT::Sample & outputSample, const OT::Interval & interval);
 
+  /** Standard constructor with in/out designs mapped from binary files */
+  Morris(const MemoryMappedSample & inputSample, const MemoryMappedSample & outputSample, const OT::Interval & interval);
+
   /** Standard constructor with levels definition, number of trajectories, model */
   Morris(const MorrisExperiment & experiment, const OT::Function & model);
 
+  /** Constructor evaluating the points in trajectory order on each worker, one sample per worker */
+  Morris(const MorrisExperiment & experiment, const OT::Function & model, const OT::UnsignedInteger workerNumber,
+         const OT::Bool reorder = false);
+
+  /** Constructor evaluating the points in trajectory order one at a time, each worker calling its own model */
+  Morris(const MorrisExperiment & experiment, const FunctionCollection & workerModels, const OT::Bool reorder = false);
+
+  /** Constructor for results added in any order, inputs being regenerated from experiment.generate(k, N, seed) */
+  Morris(const MorrisExperiment & experiment, const OT::UnsignedInteger seed, const OT::UnsignedInteger outputDimension);
+
+  /** Constructor for results added in any order together with their inputs */
+  Morris(const OT::Interval & interval, const OT::UnsignedInteger outputDimension);
+
   /** Virtual constructor method */
   Morris * clone() const override;
 
+  /** Add the output of one point of a trajectory; returns whether the trajectory is complete */
+  OT::Bool addResult(const OT::UnsignedInteger trajectoryIndex, const OT::UnsignedInteger stepIndex, const OT::Point & output);
+  OT::Bool addResult(const OT::UnsignedInteger trajectoryIndex, const OT::UnsignedInteger stepIndex, const OT::Point & input, const OT::Point & output);
+
+  /** Add trajectories, updating the statistics from the new trajectories only */
+  void add(const OT::Sample & inputSample, const OT::Sample & outputSample);
+
+  /** Add extraN trajectories drawn from experiment and evaluated by model */
+  void extend(const MorrisExperiment & experiment, const OT::Function & model, const OT::UnsignedInteger extraN);
+
+  /** Number of trajectories the effects are computed from */
+  OT::UnsignedInteger getTrajectoryNumber() const;
+
+  /** Number of trajectories waiting for some results */
+  OT::UnsignedInteger getPendingTrajectoryNumber() const;
+
+  /** Whether the effects of new trajectories are stored as floats, the statistics being accumulated in double */
+  void setSinglePrecision(const OT::Bool singlePrecision);
+  OT::Bool getSinglePrecision() const;
+
   // Get Mean/Standard deviation
   OT::Point getMeanAbsoluteElementaryEffects(const OT::UnsignedInteger outputMarginal = 0) const;
   OT::Point getMeanElementaryEffects(const OT::UnsignedInteger outputMarginal = 0) const;
   OT::Point getStandardDeviationElementaryEffects(const OT::UnsignedInteger outputMarginal = 0) const;
 
+  /** Elementary effects of each trajectory, recomputed from the samples */
+  OT::Sample getElementaryEffects(const OT::UnsignedInteger outputMarginal = 0) const;
+
+  /** Standard errors of the means, the effects of groupSize consecutive trajectories being averaged first */
+  OT::Point getMeanElementaryEffectsStandardError(const OT::UnsignedInteger outputMarginal = 0, const OT::UnsignedInteger groupSize = 1) const;
+  OT::Point getMeanAbsoluteElementaryEffectsStandardError(const OT::UnsignedInteger outputMarginal = 0, const OT::UnsignedInteger groupSize = 1) const;
+
+  /** P-values of mu* (method "output") or of |mu| (method "sign") against the absence of effect, one row per output */
+  OT::Sample computePermutationPValues(const OT::UnsignedInteger permutationNumber = 999, const OT::String & method = "output", const OT::UnsignedInteger seed = 0) const;
+
+  /** Standard deviation of the outputs of the trajectories */
+  OT::Point getOutputStandardDeviation() const;
+
+  /** mu* divided by the standard deviation of the output */
+  OT::Point getScaledMeanAbsoluteElementaryEffects(const OT::UnsignedInteger outputMarginal = 0) const;
+
+  /** mu* scaled by the standard deviation of each input, uniform over the interval or given by a distribution, over the one of the output */
+  OT::Point getNormalizedMeanAbsoluteElementaryEffects(const OT::UnsignedInteger outputMarginal = 0) const;
+  OT::Point getNormalizedMeanAbsoluteElementaryEffects(const OT::Distribution & distribution, const OT::UnsignedInteger outputMarginal = 0) const;
+
+  /** Inputs with the k largest statistics ("mu*", "mu" by absolute value or "sigma") for each output, q x k row-major */
+  OT::Indices getTopFactors(const OT::UnsignedInteger k, const OT::String & statistic = "mu*") const;
+  OT::Sample getTopFactorValues(const OT::UnsignedInteger k, const OT::String & statistic = "mu*") const;
+
+  /** Analysis of the indicators 1{y > t} of an output, smoothed if bandwidth > 0, one output per threshold */
+  Morris computeThresholdAnalysis(const OT::Point & thresholds, const OT::UnsignedInteger outputMarginal = 0, const OT::Scalar bandwidth = 0.0) const;
+
+  /** Standardized regression coefficients of the outputs on the inputs of the samples, of their ranks if rank is true, one row per output */
+  OT::Sample computeStandardRegressionCoefficients(const OT::Bool rank = false) const;
+
+  /** Coefficient of determination R^2 of the regression of each output */
+  OT::Point computeRegressionDetermination(const OT::Bool rank = false) const;
+
   // Sample accessors
   OT::Sample getInputSample() const;
   OT::Sample getOutputSample() const;
@@ -67,18 +150,121 @@ public:
   /** Method load() reloads the object from the StorageManager */
   void load(OT::Advocate & adv) override;
 
+  /** Store the object into a compact binary file, samples being optional */
+  void saveBinary(const OT::FileName & fileName, const OT::Bool saveSamples = true) const;
+
+  /** Reload an object stored by saveBinary, samples being read on first access */
+  static Morris LoadBinary(const OT::FileName & fileName);
+
+#ifndef SWIG
+  /** Binary stream versions of saveBinary/LoadBinary, samples being read at once */
+  void saveBinary(std::ostream & stream, const OT::Bool saveSamples = true) const;
+  static Morris LoadBinary(std::istream & stream);
+#endif
+
 protected:
-  // Method that allocate and compute effects
-  void computeEffects(const OT::UnsignedInteger N);
+  // Method that computes the effects of the trajectories starting every stride points of the samples and merges them,
+  // the outputs of the sharedSize first points being already merged
+  void computeEffects(const OT::Sample & inputSample, const OT::Sample & outputSample, const OT::UnsignedInteger stride, const OT::UnsignedInteger sharedSize = 0);
+
+  // Method that merges new elementary effects into mean/std
+  void mergeEffects(const OT::Sample & elementaryEffects);
+
+  // Method that merges the moments of size new elementary effects into mean/std
+  void mergeEffectMoments(const OT::UnsignedInteger size, const OT::UnsignedInteger outputDimension,
+                          OT::Point & mean, OT::Point & absoluteMean, OT::Point & squaredDeviations);
+
+  // Method that merges the moments of new outputs
+  void mergeOutputs(const OT::Point & mean, const OT::Point & squaredDeviations, const OT::UnsignedInteger size);
+
+  // Elementary effects of one trajectory, x & y being row-major blocks
+  static void ComputeTrajectoryEffects(const OT::Scalar * x, const OT::Scalar * y,
+                                       const OT::Point & diffBounds, const OT::UnsignedInteger outputDimension,
+                                       OT::Scalar * ee);
 
 private:
-  OT::Sample inputSample_;
-  OT::Sample outputSample_;
+  // Read the samples of a binary file on first access
+  void loadSamples() const;
+
+  // Check that the samples hold the trajectories of the statistics
+  void checkSamples() const;
+
+  // Evaluate the design of experiment split into one sequence of rows per model, point by point if pointwise
+  void evaluateWorkers(const MorrisExperiment & experiment, const FunctionCollection & models, const OT::Bool reorder, const OT::Bool pointwise);
+
+  // Append the trajectories starting every stride points to the samples, as independent blocks
+  void appendSamples(const OT::Sample & inputSample, const OT::Sample & outputSample, const OT::UnsignedInteger stride);
+
+  // Stride of the trajectories of the samples, checked against the statistics
+  OT::UnsignedInteger computeSampleStride() const;
+
+  // Effects of all the trajectories of the samples, N x (p*q) with the layout of ComputeTrajectoryEffects
+  OT::Sample computeSampleEffects() const;
+
+  // Partial selection of the k largest statistics of each output
+  void computeTopFactors(const OT::UnsignedInteger k, const OT::String & statistic, OT::Indices & indices, OT::Sample & values) const;
+
+  // Linear regression of the standardized outputs on the standardized inputs of the samples
+  void computeRegression(const OT::Bool rank, OT::Sample & coefficients, OT::Point & determination) const;
+
+  // Standard error of the mean of the effects, or of their absolute values, over groups of trajectories
+  OT::Point computeStandardError(const OT::UnsignedInteger outputMarginal, const OT::UnsignedInteger groupSize, const OT::Bool absolute) const;
+
+#ifndef SWIG
+  // Read a binary stream, samples being read on first access from sampleFileName if given
+  static Morris ReadBinary(std::istream & stream, const OT::FileName & sampleFileName);
+
+  // Read the descriptions, if any, and the column blocks of the samples of the given dimensions
+  static void ReadSamples(std::istream & stream, const OT::UnsignedInteger sampleSize, const OT::UnsignedInteger inputDimension, const OT::UnsignedInteger outputDimension,
+                          const OT::Bool withDescriptions, OT::Sample & inputSample, OT::Sample & outputSample);
+#endif
+
+  // Samples, possibly read lazily from sampleFileName_
+  mutable OT::Sample inputSample_;
+  mutable OT::Sample outputSample_;
+  mutable OT::FileName sampleFileName_;
+  OT::UnsignedInteger sampleOffset_;
+  // Why the samples do not hold the trajectories of the statistics, empty if they do
+  OT::String missingSamplesReason_;
   OT::Interval interval_; // Bounds
   // Elementary effects ==> N x (p*q) sample
   OT::Sample elementaryEffectsMean_;
   OT::Sample elementaryEffectsStandardDeviation_;
   OT::Sample absoluteElementaryEffectsMean_;
+  // Sum of squared deviations to the mean, needed to merge new effects
+  OT::Sample elementaryEffectsSquaredDeviations_;
+  // Number of trajectories
+  OT::UnsignedInteger trajectoryNumber_;
+  // Moments of the outputs of the trajectories, updated with the effects
+  OT::Point outputMean_;
+  OT::Point outputSquaredDeviations_;
+  OT::UnsignedInteger outputSize_;
+  // Whether the effects of new trajectories are stored as floats, the samples above remaining double
+  OT::Bool singlePrecision_;
+
+#ifndef SWIG
+  // Results of a trajectory received so far
+  struct PendingTrajectory
+  {
+    OT::Sample input_;
+    OT::Sample output_;
+    OT::Indices received_;
+    OT::UnsignedInteger receivedNumber_;
+  };
+  typedef std::map<OT::UnsignedInteger, PendingTrajectory> PendingTrajectoryMap;
+
+  // Fold a complete trajectory into the statistics
+  void foldTrajectory(const OT::UnsignedInteger trajectoryIndex, PendingTrajectory & trajectory);
+
+  // Reproducible design of the added results, if any
+  OT::Pointer<MorrisExperiment> experiment_;
+  OT::UnsignedInteger seed_;
+  OT::UnsignedInteger outputDimension_;
+  // Incomplete trajectories only
+  PendingTrajectoryMap pending_;
+  // Trajectories already folded, to discard late replicated results
+  std::vector<bool> completed_;
+#endif
 
 }; /* class Morris */
 
@@ -0,0 +1,121 @@
+//                                               -*- C++ -*-
+/**
+ *  @brief MorrisBudgetPlanner predicts the cost of Morris designs
+ *
+ *  Copyright 2005-2018 Airbus-EDF-IMACS-Phimeca
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License.
+ *
+ *  This library is distributed in the hope that it will be useful
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+ *
+ */
+#ifndef OTMORRIS_MORRISBUDGETPLANNER_HXX
+#define OTMORRIS_MORRISBUDGETPLANNER_HXX
+
+#include <openturns/Object.hxx>
+#include <openturns/Function.hxx>
+#include <openturns/Interval.hxx>
+#include "otmorris/MorrisExperiment.hxx"
+#include "otmorris/OTMORRISprivate.hxx"
+
+namespace OTMORRIS
+{
+/**
+ * @class MorrisBudgetPlanner
+ *
+ * MorrisBudgetPlanner predicts the number of evaluations, the wall time and
+ * the memory footprint of the design of an experiment for any number of
+ * trajectories, from its parameters and a per-evaluation cost, without
+ * generating anything. It gives the largest number of trajectories that fits
+ * the evaluation, time and memory budgets and the full design size.
+ */
+class OTMORRIS_API MorrisBudgetPlanner
+  : public OT::Object
+{
+  CLASSNAME
+
+public:
+  /** Default constructor */
+  MorrisBudgetPlanner();
+
+  /** Constructor from the parameters of an experiment and the output dimension of the model */
+  explicit MorrisBudgetPlanner(const MorrisExperiment & experiment, const OT::UnsignedInteger outputDimension = 1);
+
+  /** Number of distinct trajectories of the experiment */
+  OT::UnsignedInteger getFullDesignSize() const;
+
+  /** Cost of one evaluation of the model, in seconds */
+  OT::Scalar getEvaluationCost() const;
+  void setEvaluationCost(const OT::Scalar evaluationCost);
+
+  /** Time pilotSize evaluations of the model on points of the domain, sets and returns the cost */
+  OT::Scalar measureEvaluationCost(const OT::Function & model, const OT::UnsignedInteger pilotSize = 10);
+
+  /** Number of evaluations run in parallel */
+  OT::UnsignedInteger getWorkerNumber() const;
+  void setWorkerNumber(const OT::UnsignedInteger workerNumber);
+
+  /** Budgets; 0 means no limit */
+  OT::UnsignedInteger getEvaluationBudget() const;
+  void setEvaluationBudget(const OT::UnsignedInteger evaluationBudget);
+  OT::Scalar getTimeBudget() const;
+  void setTimeBudget(const OT::Scalar timeBudget);
+  OT::UnsignedInteger getMemoryBudget() const;
+  void setMemoryBudget(const OT::UnsignedInteger memoryBudget);
+
+  /** Predictions for N trajectories */
+  OT::UnsignedInteger computeEvaluationNumber(const OT::UnsignedInteger N) const;
+  OT::Scalar computeWallTime(const OT::UnsignedInteger N) const;
+
+  /** Memory of the input design, the outputs and the elementary effects, in bytes */
+  OT::UnsignedInteger computeDesignMemory(const OT::UnsignedInteger N) const;
+  OT::UnsignedInteger computeOutputMemory(const OT::UnsignedInteger N) const;
+  OT::UnsignedInteger computeEffectsMemory(const OT::UnsignedInteger N) const;
+  OT::UnsignedInteger computeMemory(const OT::UnsignedInteger N) const;
+
+  /** Reject N trajectories if the experiment cannot generate them */
+  void checkTrajectoryNumber(const OT::UnsignedInteger N) const;
+
+  /** Whether N trajectories can be generated and fit the budgets */
+  OT::Bool isFeasible(const OT::UnsignedInteger N) const;
+
+  /** Largest feasible number of trajectories */
+  OT::UnsignedInteger computeLargestTrajectoryNumber() const;
+
+  /** String converter */
+  OT::String __repr__() const override;
+
+private:
+  /** Whether N trajectories fit the budgets, computed in floating point to avoid overflows */
+  OT::Bool fitsBudgets(const OT::UnsignedInteger N) const;
+
+  // Parameters of the experiment
+  OT::UnsignedInteger inputDimension_;
+  OT::UnsignedInteger outputDimension_;
+  OT::UnsignedInteger stride_;
+  OT::UnsignedInteger fullDesignSize_;
+  // Numbers of trajectories should be multiples of it, eg antithetic pairs
+  OT::UnsignedInteger trajectoryMultiple_;
+  OT::Interval interval_;
+
+  OT::Scalar evaluationCost_;
+  OT::UnsignedInteger workerNumber_;
+  OT::UnsignedInteger evaluationBudget_;
+  OT::Scalar timeBudget_;
+  OT::UnsignedInteger memoryBudget_;
+
+}; /* class MorrisBudgetPlanner */
+
+} /* namespace OTMORRIS */
+
+#endif /* OTMORRIS_MORRISBUDGETPLANNER_HXX */
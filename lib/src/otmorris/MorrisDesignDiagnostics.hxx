@@ -0,0 +1,96 @@
+//                                               -*- C++ -*-
+/**
+ *  @brief MorrisDesignDiagnostics measures the coverage of Morris designs
+ *
+ *  Copyright 2005-2018 Airbus-EDF-IMACS-Phimeca
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License.
+ *
+ *  This library is distributed in the hope that it will be useful
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+ *
+ */
+#ifndef OTMORRIS_MORRISDESIGNDIAGNOSTICS_HXX
+#define OTMORRIS_MORRISDESIGNDIAGNOSTICS_HXX
+
+#include <openturns/Object.hxx>
+#include <openturns/Sample.hxx>
+#include <openturns/Interval.hxx>
+#include "otmorris/MorrisExperiment.hxx"
+#include "otmorris/OTMORRISprivate.hxx"
+
+namespace OTMORRIS
+{
+/**
+ * @class MorrisDesignDiagnostics
+ *
+ * MorrisDesignDiagnostics measures how well a design of trajectories covers
+ * its domain: distances between the trajectories, per-axis level
+ * histograms, centered L2 discrepancy of the base points and fraction of
+ * duplicated points. All quantities are computed in the unit cube, once,
+ * at construction; pairwise kernels run in parallel.
+ */
+class OTMORRIS_API MorrisDesignDiagnostics
+  : public OT::Object
+{
+  CLASSNAME
+
+public:
+  /** Default constructor */
+  MorrisDesignDiagnostics();
+
+  /** Constructor from a design of N*(d+1) points or of a chain of N*d+1 points, levelNumber bins per axis */
+  MorrisDesignDiagnostics(const OT::Sample & design, const OT::Interval & interval, const OT::UnsignedInteger levelNumber);
+
+  /** Constructor from a design generated by the experiment */
+  MorrisDesignDiagnostics(const MorrisExperiment & experiment, const OT::UnsignedInteger levelNumber);
+
+  /** Number of trajectories accessor */
+  OT::UnsignedInteger getTrajectoryNumber() const;
+
+  /** Distances between the centroids of the trajectories */
+  OT::Scalar getMinimumTrajectoryDistance() const;
+  OT::Scalar getMeanTrajectoryDistance() const;
+  OT::Point getNearestTrajectoryDistance() const;
+
+  /** Number of points per level, one row per input */
+  OT::Sample getLevelHistogram() const;
+
+  /** Fraction of the levels reached, per input */
+  OT::Point getLevelCoverage() const;
+
+  /** Centered L2 discrepancy of the base points */
+  OT::Scalar getBaseDiscrepancy() const;
+
+  /** Fraction of the points equal to another point of the design */
+  OT::Scalar getDuplicateFraction() const;
+
+  /** String converter */
+  OT::String __repr__() const override;
+
+private:
+  /** Compute all the diagnostics, the trajectories starting every stride points */
+  void run(const OT::Sample & design, const OT::Interval & interval, const OT::UnsignedInteger stride);
+
+  OT::UnsignedInteger levelNumber_;
+  OT::UnsignedInteger trajectoryNumber_;
+  OT::Scalar meanTrajectoryDistance_;
+  OT::Point nearestTrajectoryDistance_;
+  OT::Sample levelHistogram_;
+  OT::Scalar baseDiscrepancy_;
+  OT::Scalar duplicateFraction_;
+
+}; /* class MorrisDesignDiagnostics */
+
+} /* namespace OTMORRIS */
+
+#endif /* OTMORRIS_MORRISDESIGNDIAGNOSTICS_HXX */
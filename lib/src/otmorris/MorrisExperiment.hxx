@@ -29,6 +29,7 @@
 #include <openturns/Indices.hxx>
 #include <openturns/Matrix.hxx>
 #include <openturns/WeightedExperiment.hxx>
+#include <iosfwd>
 #include "otmorris/OTMORRISprivate.hxx"
 
 namespace OTMORRIS
@@ -59,9 +60,25 @@ public:
   /* Get the interval values */
   OT::Interval getBounds() const;
 
+  /** Number of trajectories accessors */
+  OT::UnsignedInteger getTrajectoryNumber() const;
+  virtual void setTrajectoryNumber(const OT::UnsignedInteger N);
+
+  /** Number of points between the starts of two consecutive trajectories of generate() */
+  virtual OT::UnsignedInteger getTrajectoryStride() const;
+
+  /** Number of distinct trajectories that can be generated */
+  virtual OT::UnsignedInteger getFullDesignSize() const;
+
   /** Generate method */
   OT::Sample generate() const override;
 
+  /** Generate the trajectories of one shard of a reproducible design */
+  virtual OT::Sample generate(const OT::UnsignedInteger shardIndex, const OT::UnsignedInteger shardCount, const OT::UnsignedInteger seed) const;
+
+  /** Generate method writing the trajectories one by one into a file */
+  virtual void generateToFile(const OT::FileName & fileName, const OT::String & format = "npy") const;
+
   /** String converter */
   OT::String __repr__() const override;
 
@@ -71,8 +88,29 @@ public:
   /** Method load() reloads the object from the StorageManager */
   void load(OT::Advocate & adv) override;
 
+#ifndef SWIG
+  /** Compact binary state of the parameters, used for pickling */
+  virtual void saveBinary(std::ostream & stream) const;
+  virtual void loadBinary(std::istream & stream);
+#endif
+
 protected:
 
+  /** Range of the trajectories of a shard */
+  void computeShardRange(const OT::UnsignedInteger shardIndex, const OT::UnsignedInteger shardCount,
+                         OT::UnsignedInteger & first, OT::UnsignedInteger & last) const;
+
+  /** Number of levels of the grid along an input, delta_ being 1 / (levels - 1) */
+  OT::UnsignedInteger getLevelNumber(const OT::UnsignedInteger k) const;
+
+  /** Hash of a trajectory, used to filter replicates without storing them */
+  static OT::UnsignedInteger HashTrajectory(const OT::Sample & trajectory);
+
+#ifndef SWIG
+  /** Read the binary state of the parameters, returning the version it was saved with */
+  OT::UnsignedInteger loadBinaryState(std::istream & stream);
+#endif
+
   // Bounds
   OT::Interval interval_;
 
@@ -52,34 +52,69 @@ public:
   /** Generate method */
   OT::Sample generate() const override;
 
+  /** Generate the trajectories of one shard of a reproducible design */
+  OT::Sample generate(const OT::UnsignedInteger shardIndex, const OT::UnsignedInteger shardCount, const OT::UnsignedInteger seed) const override;
+
+  /** Generate method writing the trajectories one by one into a file */
+  void generateToFile(const OT::FileName & fileName, const OT::String & format = "npy") const override;
+
   /** String converter */
   OT::String __repr__() const override;
 
+  /** Number of trajectories accessor, checked against the full design size */
+  void setTrajectoryNumber(const OT::UnsignedInteger N) override;
+
   /** get/set jumpStep */
   OT::Indices getJumpStep() const;
 
   void setJumpStep(const OT::Indices & jumpStep);
 
+  /** Number of distinct trajectories that can be generated */
+  OT::UnsignedInteger getFullDesignSize() const override;
+
+  /** Antithetic pairs accessors */
+  OT::Bool getAntithetic() const;
+  void setAntithetic(const OT::Bool antithetic);
+
   /** Method save() stores the object through the StorageManager */
   void save(OT::Advocate & adv) const override;
 
   /** Method load() reloads the object from the StorageManager */
   void load(OT::Advocate & adv) override;
 
+#ifndef SWIG
+  /** Compact binary state of the parameters, used for pickling */
+  void saveBinary(std::ostream & stream) const override;
+  void loadBinary(std::istream & stream) override;
+#endif
+
 protected:
 
   /** Default constructor for save/load mechanism */
-  MorrisExperimentGrid() {};
+  MorrisExperimentGrid() : antithetic_(false) {};
   friend class OT::Factory<MorrisExperimentGrid>;
 
   /** Generate a trajectory */
   OT::Sample generateTrajectory() const;
 
+  /** Build the trajectory from its starting point (in grid units), axes order and directions */
+  OT::Sample buildTrajectory(OT::Point xBase, const OT::Indices & permutation, const OT::Point & directions) const;
+
+  /** Mirror of a trajectory through the center of the domain */
+  OT::Sample mirrorTrajectory(const OT::Sample & trajectory) const;
+
+  /** Trajectory of a reproducible design from the index of its starting point code */
+  OT::Sample generateCodedTrajectory(const OT::UnsignedInteger index, const OT::Indices & radix, const OT::UnsignedInteger codeSize,
+                                     const OT::UnsignedInteger codedAxes, const OT::UnsignedInteger seed) const;
+
 private:
 
   // jumpStep: integers!
   OT::Indices jumpStep_;
 
+  // Whether trajectories come in mirrored pairs
+  OT::Bool antithetic_;
+
 }; /* class MorrisExperimentGrid */
 
 } /* namespace OTMORRIS */
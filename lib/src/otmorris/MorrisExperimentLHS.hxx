@@ -46,12 +46,24 @@ public:
   /** Constructor using Sample, which is supposed to be an LHS design */
   MorrisExperimentLHS(const OT::Sample & lhsDesign, const OT::Interval & interval, const OT::UnsignedInteger N);
 
+  /** Constructor building a space-filling LHS design of the given size; criterion is "maximin" or "C2" */
+  MorrisExperimentLHS(const OT::UnsignedInteger size, const OT::Interval & interval, const OT::UnsignedInteger N, const OT::String & criterion = "maximin");
+
   /** Virtual constructor method */
   MorrisExperimentLHS * clone() const override;
 
+  /** Number of distinct trajectories that can be generated */
+  OT::UnsignedInteger getFullDesignSize() const override;
+
   /** Generate method */
   OT::Sample generate() const override;
 
+  /** Generate the trajectories of one shard of a reproducible design */
+  OT::Sample generate(const OT::UnsignedInteger shardIndex, const OT::UnsignedInteger shardCount, const OT::UnsignedInteger seed) const override;
+
+  /** Generate method writing the trajectories one by one into a file */
+  void generateToFile(const OT::FileName & fileName, const OT::String & format = "npy") const override;
+
   /** String converter */
   OT::String __repr__() const override;
 
@@ -61,6 +73,12 @@ public:
   /** Method load() reloads the object from the StorageManager */
   void load(OT::Advocate & adv) override;
 
+#ifndef SWIG
+  /** Compact binary state of the parameters, used for pickling */
+  void saveBinary(std::ostream & stream) const override;
+  void loadBinary(std::istream & stream) override;
+#endif
+
 protected:
   /** Default constructor for save/load mechanism */
   MorrisExperimentLHS() {};
@@ -69,6 +87,12 @@ protected:
   // generate method with lhs design
   OT::Point generateXBaseFromLHS() const;
 
+  /** Optimized centered LHS design of the interval */
+  static OT::Sample BuildSpaceFillingDesign(const OT::UnsignedInteger size, const OT::Interval & interval, const OT::String & criterion);
+
+  /** Draw the indices of the starting points in the LHS design */
+  OT::Indices drawStartingIndices() const;
+
 
 private:
 
@@ -78,6 +102,9 @@ private:
   /** Generate 1 trajectory */
   OT::Sample generateTrajectory(const OT::UnsignedInteger index) const;
 
+  /** Build the trajectory from its starting point index, axes order and directions */
+  OT::Sample buildTrajectory(const OT::UnsignedInteger index, const OT::Indices & permutation, const OT::Point & directions) const;
+
 }; /* class MorrisExperimentLHS */
 
 } /* namespace OTMORRIS */
@@ -0,0 +1,87 @@
+//                                               -*- C++ -*-
+/**
+ *  @brief MorrisExperimentWindingStairs generates winding stairs experiments
+ *  for Morris on grids.
+ *
+ *  Copyright 2005-2018 Airbus-EDF-IMACS-Phimeca
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License.
+ *
+ *  This library is distributed in the hope that it will be useful
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+ *
+ */
+#ifndef OTMORRIS_MORRISEXPERIMENTWINDINGSTAIRS_HXX
+#define OTMORRIS_MORRISEXPERIMENTWINDINGSTAIRS_HXX
+
+#include "otmorris/MorrisExperiment.hxx"
+
+namespace OTMORRIS
+{
+/**
+ * @class MorrisExperimentWindingStairs
+ *
+ * MorrisExperimentWindingStairs builds a single chain of points on a grid
+ * where each step moves the next factor in cyclic order. Each cycle of d
+ * steps is a trajectory whose last point is the first point of the next
+ * one, so that N trajectories only need N*d+1 evaluations.
+ */
+class OTMORRIS_API MorrisExperimentWindingStairs
+  : public MorrisExperiment
+{
+  CLASSNAME
+
+public:
+
+  /** Constructor using a p-level grid - Uniform(0,1)^d */
+  MorrisExperimentWindingStairs(const OT::Indices & levels, const OT::UnsignedInteger N);
+
+  /** Constructor using a p-level grid and intervals*/
+  MorrisExperimentWindingStairs(const OT::Indices & levels, const OT::Interval & interval, const OT::UnsignedInteger N);
+
+  /** Virtual constructor method */
+  MorrisExperimentWindingStairs * clone() const override;
+
+  /** Generate the chain of N*d+1 points */
+  OT::Sample generate() const override;
+
+  /** Generate the trajectories of one shard of a reproducible chain, as separate blocks of d+1 points */
+  OT::Sample generate(const OT::UnsignedInteger shardIndex, const OT::UnsignedInteger shardCount, const OT::UnsignedInteger seed) const override;
+
+  /** Number of trajectories accessor */
+  void setTrajectoryNumber(const OT::UnsignedInteger N) override;
+
+  /** Number of points between the starts of two consecutive trajectories */
+  OT::UnsignedInteger getTrajectoryStride() const override;
+
+  /** String converter */
+  OT::String __repr__() const override;
+
+#ifndef SWIG
+  /** Compact binary state of the parameters, used for pickling */
+  void loadBinary(std::istream & stream) override;
+#endif
+
+protected:
+
+  /** Default constructor for save/load mechanism */
+  MorrisExperimentWindingStairs() {};
+  friend class OT::Factory<MorrisExperimentWindingStairs>;
+
+  /** Chain of the cycles firstCycle to firstCycle + cycleNumber - 1, fully determined by the seed */
+  OT::Sample buildChain(const OT::UnsignedInteger firstCycle, const OT::UnsignedInteger cycleNumber, const OT::UnsignedInteger seed) const;
+
+}; /* class MorrisExperimentWindingStairs */
+
+} /* namespace OTMORRIS */
+
+#endif /* OTMORRIS_MORRISEXPERIMENTWINDINGSTAIRS_HXX */
@@ -0,0 +1,84 @@
+//                                               -*- C++ -*-
+/**
+ *  @brief MorrisGivenData estimates Morris statistics from arbitrary samples
+ *
+ *  Copyright 2005-2018 Airbus-EDF-IMACS-Phimeca
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License.
+ *
+ *  This library is distributed in the hope that it will be useful
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+ *
+ */
+#ifndef OTMORRIS_MORRISGIVENDATA_HXX
+#define OTMORRIS_MORRISGIVENDATA_HXX
+
+#include <openturns/Object.hxx>
+#include <openturns/Collection.hxx>
+#include <openturns/Indices.hxx>
+#include <openturns/Interval.hxx>
+#include <openturns/Sample.hxx>
+#include "otmorris/OTMORRISprivate.hxx"
+
+namespace OTMORRIS
+{
+/**
+ * @class MorrisGivenData
+ *
+ * MorrisGivenData estimates the Morris statistics from samples that were
+ * not generated as trajectories. A k-d tree is built on the inputs scaled
+ * into the unit cube; each point is paired, for each input, with its
+ * nearest neighbour whose difference is mainly along that input, and the
+ * elementary effect of the pair is the output difference over the scaled
+ * step along the input. Neighbour queries run in parallel.
+ */
+class OTMORRIS_API MorrisGivenData
+  : public OT::Object
+{
+  CLASSNAME
+
+public:
+  /** Default constructor */
+  MorrisGivenData();
+
+  /** Constructor from samples, searching the pairs among the neighbourNumber nearest neighbours of each point */
+  MorrisGivenData(const OT::Sample & inputSample, const OT::Sample & outputSample, const OT::Interval & interval,
+                  const OT::UnsignedInteger neighbourNumber = 20, const OT::Scalar alignment = 0.8);
+
+  /** Number of pairs per input */
+  OT::Indices getPairNumber() const;
+
+  /** Pairs of point indices used for an input, as a flat sequence of (first, second) */
+  OT::Indices getPairs(const OT::UnsignedInteger input) const;
+
+  /** Statistics of the elementary effects of the pairs */
+  OT::Point getMeanElementaryEffects(const OT::UnsignedInteger outputMarginal = 0) const;
+  OT::Point getMeanAbsoluteElementaryEffects(const OT::UnsignedInteger outputMarginal = 0) const;
+  OT::Point getStandardDeviationElementaryEffects(const OT::UnsignedInteger outputMarginal = 0) const;
+
+  /** String converter */
+  OT::String __repr__() const override;
+
+private:
+  OT::UnsignedInteger neighbourNumber_;
+  OT::Scalar alignment_;
+  OT::Collection<OT::Indices> pairs_;
+  // q x p samples
+  OT::Sample elementaryEffectsMean_;
+  OT::Sample absoluteElementaryEffectsMean_;
+  OT::Sample elementaryEffectsStandardDeviation_;
+
+}; /* class MorrisGivenData */
+
+} /* namespace OTMORRIS */
+
+#endif /* OTMORRIS_MORRISGIVENDATA_HXX */
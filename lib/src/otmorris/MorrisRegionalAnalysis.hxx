@@ -0,0 +1,113 @@
+//                                               -*- C++ -*-
+/**
+ *  @brief MorrisRegionalAnalysis computes Morris statistics per region of the input domain
+ *
+ *  Copyright 2005-2018 Airbus-EDF-IMACS-Phimeca
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License.
+ *
+ *  This library is distributed in the hope that it will be useful
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+ *
+ */
+#ifndef OTMORRIS_MORRISREGIONALANALYSIS_HXX
+#define OTMORRIS_MORRISREGIONALANALYSIS_HXX
+
+#include <openturns/Object.hxx>
+#include <openturns/Collection.hxx>
+#include <openturns/Function.hxx>
+#include <openturns/Indices.hxx>
+#include <openturns/Interval.hxx>
+#include <openturns/Sample.hxx>
+#include "otmorris/Morris.hxx"
+#include "otmorris/OTMORRISprivate.hxx"
+
+namespace OTMORRIS
+{
+/**
+ * @class MorrisRegionalAnalysis
+ *
+ * MorrisRegionalAnalysis assigns each trajectory of a Morris analysis to a
+ * region of the input domain according to its base point, then computes
+ * the mean, mean absolute value and standard deviation of the elementary
+ * effects of each region. Regions are either the cells of a regular grid,
+ * the leaves of a k-d tree built on the base points or given by a
+ * function. Statistics are computed once, at construction, from the
+ * samples held by the analysis: the model is not evaluated again.
+ */
+class OTMORRIS_API MorrisRegionalAnalysis
+  : public OT::Object
+{
+  CLASSNAME
+
+public:
+  typedef OT::Collection<OT::Interval> IntervalCollection;
+  typedef OT::Collection<OT::Sample>   SampleCollection;
+
+  /** Default constructor */
+  MorrisRegionalAnalysis();
+
+  /** Constructor with a regular grid of binNumber[j] cells along input j */
+  MorrisRegionalAnalysis(const Morris & morris, const OT::Indices & binNumber);
+
+  /** Constructor with the leaves of a k-d tree holding at most leafSize base points */
+  MorrisRegionalAnalysis(const Morris & morris, const OT::UnsignedInteger leafSize);
+
+  /** Constructor with a function mapping a base point to its region index */
+  MorrisRegionalAnalysis(const Morris & morris, const OT::Function & regionFunction);
+
+  /** Number of regions accessor */
+  OT::UnsignedInteger getRegionNumber() const;
+
+  /** Bounds of a region */
+  OT::Interval getRegion(const OT::UnsignedInteger region) const;
+
+  /** Region of each trajectory */
+  OT::Indices getRegionIndices() const;
+
+  /** Number of trajectories of a region */
+  OT::UnsignedInteger getTrajectoryNumber(const OT::UnsignedInteger region) const;
+
+  /** Statistics of the elementary effects of a region */
+  OT::Point getMeanElementaryEffects(const OT::UnsignedInteger region, const OT::UnsignedInteger outputMarginal = 0) const;
+  OT::Point getMeanAbsoluteElementaryEffects(const OT::UnsignedInteger region, const OT::UnsignedInteger outputMarginal = 0) const;
+  OT::Point getStandardDeviationElementaryEffects(const OT::UnsignedInteger region, const OT::UnsignedInteger outputMarginal = 0) const;
+
+  /** String converter */
+  OT::String __repr__() const override;
+
+private:
+  /** Base point of each trajectory */
+  static OT::Sample ComputeBasePoints(const Morris & morris);
+
+  /** Split the base points of the indices into k-d cells */
+  void buildKDCells(const OT::Sample & basePoints, const OT::Indices & indices, const OT::Interval & cell, const OT::UnsignedInteger leafSize);
+
+  /** Accumulate the statistics of each region in one pass over the trajectories */
+  void run(const Morris & morris);
+
+  /** Check a region/marginal pair */
+  void checkRegion(const OT::UnsignedInteger region, const OT::UnsignedInteger outputMarginal) const;
+
+  IntervalCollection regions_;
+  OT::Indices regionIndices_;
+  OT::Indices trajectoryNumber_;
+  // One q x p sample per region
+  SampleCollection elementaryEffectsMean_;
+  SampleCollection absoluteElementaryEffectsMean_;
+  SampleCollection elementaryEffectsStandardDeviation_;
+
+}; /* class MorrisRegionalAnalysis */
+
+} /* namespace OTMORRIS */
+
+#endif /* OTMORRIS_MORRISREGIONALANALYSIS_HXX */
@@ -0,0 +1,106 @@
+//                                               -*- C++ -*-
+/**
+ *  @brief MorrisRun runs the Morris method in the background
+ *
+ *  Copyright 2005-2018 Airbus-EDF-IMACS-Phimeca
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License.
+ *
+ *  This library is distributed in the hope that it will be useful
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+ *
+ */
+#ifndef OTMORRIS_MORRISRUN_HXX
+#define OTMORRIS_MORRISRUN_HXX
+
+#include <openturns/Object.hxx>
+#include <openturns/Pointer.hxx>
+#include <openturns/Function.hxx>
+#ifndef SWIG
+#include <future>
+#endif
+#include "otmorris/OTMORRISprivate.hxx"
+#include "otmorris/MorrisExperiment.hxx"
+#include "otmorris/Morris.hxx"
+
+namespace OTMORRIS
+{
+
+class MorrisRunState;
+
+/**
+ * @class MorrisRun
+ *
+ * MorrisRun generates the design of an experiment and evaluates the model
+ * by blocks of trajectories in a background thread. The handle gives the
+ * progress, the statistics of the trajectories evaluated so far and the
+ * final Morris object. Copies share the same run, which is cancelled when
+ * the last copy is destroyed.
+ */
+class OTMORRIS_API MorrisRun
+  : public OT::Object
+{
+  CLASSNAME
+
+public:
+  /** Default constructor */
+  MorrisRun();
+
+  /** Constructor, starts the run; the model is evaluated on blockSize trajectories at a time */
+  MorrisRun(const MorrisExperiment & experiment, const OT::Function & model, const OT::UnsignedInteger blockSize = 16);
+
+  /** Number of evaluations done/to do */
+  OT::UnsignedInteger getEvaluationNumber() const;
+  OT::UnsignedInteger getTotalEvaluationNumber() const;
+
+  /** Progress, between 0 and 1 */
+  OT::Scalar getProgress() const;
+
+  /** Time since the start, in seconds */
+  OT::Scalar getElapsedTime() const;
+
+  /** Remaining time from the measured time per evaluation, in seconds */
+  OT::Scalar getEstimatedRemainingTime() const;
+
+  /** Statistics of the trajectories evaluated so far */
+  Morris getSnapshot() const;
+
+  /** Stop the run after the block being evaluated */
+  void cancel();
+
+  /** Status accessors, a run being cancelled only if it stopped before its last block */
+  OT::Bool isDone() const;
+  OT::Bool isCancelled() const;
+
+  /** Wait for the end of the run */
+  void wait() const;
+
+  /** Final result, partial if the run was cancelled; waits for the end of the run */
+  Morris getResult() const;
+
+#ifndef SWIG
+  /** Future of the final result */
+  std::shared_future<Morris> getFuture() const;
+#endif
+
+  /** String converter */
+  OT::String __repr__() const override;
+
+private:
+  // Shared with the background thread
+  OT::Pointer<MorrisRunState> state_;
+
+}; /* class MorrisRun */
+
+} /* namespace OTMORRIS */
+
+#endif /* OTMORRIS_MORRISRUN_HXX */
@@ -0,0 +1,67 @@
+//                                               -*- C++ -*-
+/**
+ *  @brief RandomStream is a small counter-based generator giving
+ *  reproducible, independent random streams
+ *
+ *  Copyright 2005-2018 Airbus-EDF-IMACS-Phimeca
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License.
+ *
+ *  This library is distributed in the hope that it will be useful
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+ *
+ */
+#ifndef OTMORRIS_RANDOMSTREAM_HXX
+#define OTMORRIS_RANDOMSTREAM_HXX
+
+#include <cstdint>
+#include <openturns/Indices.hxx>
+#include "otmorris/OTMORRISprivate.hxx"
+
+namespace OTMORRIS
+{
+/**
+ * @class RandomStream
+ *
+ * RandomStream draws from a splitmix64 sequence fully determined by a
+ * (seed, stream) pair. Contrary to OT::RandomGenerator it has no global
+ * state, so that the draws of a trajectory do not depend on the ones of
+ * the other trajectories nor on the thread which generates it.
+ */
+class OTMORRIS_API RandomStream
+{
+public:
+  /** Constructor */
+  RandomStream(const OT::UnsignedInteger seed, const OT::UnsignedInteger stream);
+
+  /** Uniform integer in [0, n) */
+  OT::UnsignedInteger integerGenerate(const OT::UnsignedInteger n);
+
+  /** Uniform real in [0, 1) */
+  OT::Scalar generate();
+
+  /** Uniform random permutation of [0, n) */
+  OT::Indices permutation(const OT::UnsignedInteger n);
+
+  /** Pseudo-random bijection of [0, size) keyed by key, evaluated at index */
+  static OT::UnsignedInteger Permute(const OT::UnsignedInteger index, const OT::UnsignedInteger size, const OT::UnsignedInteger key);
+
+private:
+  std::uint64_t next();
+
+  std::uint64_t state_;
+
+}; /* class RandomStream */
+
+} /* namespace OTMORRIS */
+
+#endif /* OTMORRIS_RANDOMSTREAM_HXX */
@@ -0,0 +1,77 @@
+//                                               -*- C++ -*-
+/**
+ *  @brief SpaceFillingLHS builds optimized centered LHS designs
+ *
+ *  Copyright 2005-2018 Airbus-EDF-IMACS-Phimeca
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License.
+ *
+ *  This library is distributed in the hope that it will be useful
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+ *
+ */
+#ifndef OTMORRIS_SPACEFILLINGLHS_HXX
+#define OTMORRIS_SPACEFILLINGLHS_HXX
+
+#include <openturns/Sample.hxx>
+#include "otmorris/OTMORRISprivate.hxx"
+
+namespace OTMORRIS
+{
+/**
+ * @class SpaceFillingLHS
+ *
+ * SpaceFillingLHS optimizes a centered LHS design of [0,1]^d by simulated
+ * annealing on swaps of two levels of a column. The criterion is either
+ * "maximin", through the phi_p smoothing of the minimal distance, or "C2",
+ * the centered L2 discrepancy. Pairwise terms are cached so that a swap is
+ * evaluated in O(size). Independent starts run in parallel, each one with
+ * its own random stream, and the best design is kept.
+ */
+class OTMORRIS_API SpaceFillingLHS
+{
+public:
+  /** Constructor */
+  SpaceFillingLHS(const OT::UnsignedInteger size, const OT::UnsignedInteger dimension, const OT::String & criterion = "maximin");
+
+  /** Number of independent starts accessor */
+  void setStartNumber(const OT::UnsignedInteger startNumber);
+
+  /** Number of swaps per start accessor */
+  void setIterationNumber(const OT::UnsignedInteger iterationNumber);
+
+  /** Best design over the starts, fully determined by the seed */
+  OT::Sample generate(const OT::UnsignedInteger seed) const;
+
+  /** Criterion of a design of [0,1]^d, the lower the better */
+  OT::Scalar computeCriterion(const OT::Sample & design) const;
+
+  /** Size above which pairwise terms are recomputed instead of cached */
+  static const OT::UnsignedInteger MaximumCachedSize;
+
+private:
+  friend struct SpaceFillingLHSPolicy;
+
+  /** Optimize from the start-th random design; levels are column-major */
+  OT::Scalar optimize(const OT::UnsignedInteger seed, const OT::UnsignedInteger start, OT::Indices & levels) const;
+
+  OT::UnsignedInteger size_;
+  OT::UnsignedInteger dimension_;
+  OT::String criterion_;
+  OT::UnsignedInteger startNumber_;
+  OT::UnsignedInteger iterationNumber_;
+
+}; /* class SpaceFillingLHS */
+
+} /* namespace OTMORRIS */
+
+#endif /* OTMORRIS_SPACEFILLINGLHS_HXX */
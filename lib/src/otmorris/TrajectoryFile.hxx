@@ -0,0 +1,89 @@
+//                                               -*- C++ -*-
+/**
+ *  @brief TrajectoryFile writes Morris designs trajectory by trajectory
+ *  together with an index of the trajectories
+ *
+ *  Copyright 2005-2018 Airbus-EDF-IMACS-Phimeca
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License.
+ *
+ *  This library is distributed in the hope that it will be useful
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+ *
+ */
+#ifndef OTMORRIS_TRAJECTORYFILE_HXX
+#define OTMORRIS_TRAJECTORYFILE_HXX
+
+#include <openturns/Object.hxx>
+#include <openturns/Collection.hxx>
+#include <openturns/Pointer.hxx>
+#include <openturns/Sample.hxx>
+#include "otmorris/OTMORRISprivate.hxx"
+
+namespace OTMORRIS
+{
+
+class TrajectoryWriter;
+
+/**
+ * @class TrajectoryFile
+ *
+ * TrajectoryFile appends trajectories to a .npy, raw binary or CSV file
+ * with bounded memory, binary files holding float64 or float32 values. On close, an index holding the byte offset of each
+ * trajectory is written next to the file (fileName + ".index") so that any
+ * range of trajectories can be read back without scanning the file.
+ * The file is also closed when the last copy of the object is destroyed.
+ */
+class OTMORRIS_API TrajectoryFile
+  : public OT::Object
+{
+  CLASSNAME
+
+public:
+  /** Default constructor */
+  TrajectoryFile();
+
+  /** Constructor; format is one of "npy", "raw", "npy32", "raw32" (float32 values) or "csv" */
+  TrajectoryFile(const OT::FileName & fileName, const OT::UnsignedInteger dimension, const OT::String & format = "npy");
+
+  /** Append one trajectory */
+  void add(const OT::Sample & trajectory);
+
+  /** Finalize the file header and write the index */
+  void close();
+
+  /** Number of trajectories written so far */
+  OT::UnsignedInteger getTrajectoryNumber() const;
+
+  /** File name accessors */
+  OT::FileName getFileName() const;
+  OT::FileName getIndexFileName() const;
+
+  /** Read count trajectories starting from first using the index */
+  static OT::Sample Read(const OT::FileName & fileName, const OT::UnsignedInteger first, const OT::UnsignedInteger count);
+
+  /** String converter */
+  OT::String __repr__() const override;
+
+private:
+  OT::FileName fileName_;
+  OT::String format_;
+  OT::UnsignedInteger dimension_;
+
+  // Stream and trajectory offsets shared by the copies, closed by close() or by the last copy
+  OT::Pointer<TrajectoryWriter> writer_;
+
+}; /* class TrajectoryFile */
+
+} /* namespace OTMORRIS */
+
+#endif /* OTMORRIS_TRAJECTORYFILE_HXX */
@@ -0,0 +1,59 @@
+#include <iostream>
+
+// OT includes
+#include <openturns/OT.hxx>
+#include "otmorris/MorrisDesignDiagnostics.hxx"
+
+using namespace OT;
+using namespace OTMORRIS;
+
+static void PrintDiagnostics(const MorrisDesignDiagnostics & diagnostics)
+{
+  std::cout << "trajectories=" << diagnostics.getTrajectoryNumber() << std::endl;
+  std::cout << "minimum trajectory distance=" << diagnostics.getMinimumTrajectoryDistance() << std::endl;
+  std::cout << "mean trajectory distance=" << diagnostics.getMeanTrajectoryDistance() << std::endl;
+  const Sample histogram(diagnostics.getLevelHistogram());
+  for (UnsignedInteger k = 0; k < histogram.getSize(); ++k)
+  {
+    std::cout << "level histogram of input " << k << "=";
+    for (UnsignedInteger l = 0; l < histogram.getDimension(); ++l)
+      std::cout << (l > 0 ? " " : "") << histogram(k, l);
+    std::cout << std::endl;
+  }
+  std::cout << "level coverage=" << diagnostics.getLevelCoverage() << std::endl;
+  std::cout << "base discrepancy=" << diagnostics.getBaseDiscrepancy() << std::endl;
+  std::cout << "duplicate fraction=" << diagnostics.getDuplicateFraction() << std::endl;
+}
+
+int main(void)
+{
+  // Two trajectories of a 3-level grid in [-1,3]^2 sharing their last point
+  const Interval bounds(Point(2, -1.0), Point(2, 3.0));
+  const Scalar points[6][2] = {{-1, -1}, {1, -1}, {1, 1}, {3, 3}, {1, 3}, {1, 1}};
+  Sample design(6, 2);
+  for (UnsignedInteger i = 0; i < 6; ++i)
+    for (UnsignedInteger j = 0; j < 2; ++j)
+      design(i, j) = points[i][j];
+  std::cout << "Independent trajectories" << std::endl;
+  PrintDiagnostics(MorrisDesignDiagnostics(design, bounds, 3));
+
+  // Winding stairs chain of 2 trajectories, the last point of one being the first of the next
+  const Scalar chainPoints[5][2] = {{-1, -1}, {1, -1}, {1, 1}, {3, 1}, {3, 3}};
+  Sample chain(5, 2);
+  for (UnsignedInteger i = 0; i < 5; ++i)
+    for (UnsignedInteger j = 0; j < 2; ++j)
+      chain(i, j) = chainPoints[i][j];
+  std::cout << "Chain" << std::endl;
+  PrintDiagnostics(MorrisDesignDiagnostics(chain, bounds, 3));
+
+  try
+  {
+    MorrisDesignDiagnostics(design, bounds, 0);
+    std::cout << "no level accepted" << std::endl;
+  }
+  catch (const InvalidArgumentException &)
+  {
+    std::cout << "no level rejected" << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,114 @@
+#include <iostream>
+#include <sstream>
+#include <cstdint>
+
+// OT includes
+#include <openturns/OT.hxx>
+#include "otmorris/MorrisExperimentGrid.hxx"
+#include "otmorris/MorrisExperimentLHS.hxx"
+#include "otmorris/MorrisExperimentWindingStairs.hxx"
+
+using namespace OT;
+using namespace OTMORRIS;
+
+// Whether trajectories k and l of a design hold the same points
+static Bool SameTrajectory(const Sample & design, const UnsignedInteger k, const UnsignedInteger l)
+{
+  const UnsignedInteger dimension = design.getDimension();
+  for (UnsignedInteger i = 0; i <= dimension; ++i)
+    for (UnsignedInteger j = 0; j < dimension; ++j)
+      if (design(k * (dimension + 1) + i, j) != design(l * (dimension + 1) + i, j)) return false;
+  return true;
+}
+
+// Number of distinct trajectories of a design
+static UnsignedInteger DistinctTrajectoryNumber(const Sample & design)
+{
+  const UnsignedInteger N = design.getSize() / (design.getDimension() + 1);
+  UnsignedInteger distinct = 0;
+  for (UnsignedInteger k = 0; k < N; ++k)
+  {
+    Bool replicate = false;
+    for (UnsignedInteger l = 0; (l < k) && !replicate; ++l)
+      replicate = SameTrajectory(design, k, l);
+    if (!replicate) ++distinct;
+  }
+  return distinct;
+}
+
+// Check the shards of a reproducible design against the whole design
+static void CheckShards(const String & name, const MorrisExperiment & experiment, const Bool distinct = true)
+{
+  const UnsignedInteger seed = 1234;
+  RandomGenerator::SetSeed(0);
+  const Sample full(experiment.generate(0, 1, seed));
+  // Does not depend on the global generator
+  RandomGenerator::SetSeed(77);
+  const Bool reproducible = (experiment.generate(0, 1, seed) == full);
+  const UnsignedInteger dimension = full.getDimension();
+  std::cout << name << ": trajectories=" << full.getSize() / (dimension + 1)
+            << ", reproducible=" << reproducible << std::endl;
+  if (distinct)
+    std::cout << name << ": distinct trajectories=" << DistinctTrajectoryNumber(full) << std::endl;
+  const UnsignedInteger shardCounts[3] = {2, 3, 7};
+  for (UnsignedInteger n = 0; n < 3; ++n)
+  {
+    Sample shards(0, dimension);
+    for (UnsignedInteger shardIndex = 0; shardIndex < shardCounts[n]; ++shardIndex)
+      shards.add(experiment.generate(shardIndex, shardCounts[n], seed));
+    std::cout << name << ": " << shardCounts[n] << " shards match the whole design=" << (shards == full) << std::endl;
+  }
+  std::cout << name << ": another seed changes the design=" << !(experiment.generate(0, 1, seed + 1) == full) << std::endl;
+}
+
+int main(void)
+{
+  std::cout << std::boolalpha;
+  const UnsignedInteger dimension = 4;
+  const Interval bounds(Point(dimension, 0.0), Point(dimension, 1.0));
+  Indices levels(dimension);
+  levels.fill(5, 0);
+
+  const MorrisExperimentGrid grid(levels, bounds, 50);
+  CheckShards("grid", grid);
+
+  MorrisExperimentGrid antithetic(levels, bounds, 20);
+  antithetic.setAntithetic(true);
+  CheckShards("antithetic grid", antithetic);
+  // Odd trajectories are the mirrors of the previous ones
+  const Sample pairs(antithetic.generate(0, 1, 1234));
+  Bool mirrored = true;
+  for (UnsignedInteger i = 0; i < pairs.getSize(); i += 2 * (dimension + 1))
+    for (UnsignedInteger p = 0; p <= dimension; ++p)
+      for (UnsignedInteger j = 0; j < dimension; ++j)
+        mirrored = mirrored && (pairs(i + p, j) + pairs(i + dimension + 1 + p, j) == 1.0);
+  std::cout << "antithetic grid: pairs are mirrored=" << mirrored << std::endl;
+
+  RandomGenerator::SetSeed(0);
+  const Sample lhsDesign(LHSExperiment(ComposedDistribution(Collection<Distribution>(dimension, Uniform(0.0, 1.0))), 30, true, false).generate());
+  CheckShards("lhs", MorrisExperimentLHS(lhsDesign, 20));
+  // More trajectories than starting points
+  CheckShards("lhs reusing starts", MorrisExperimentLHS(lhsDesign, 45));
+
+  const MorrisExperimentWindingStairs windingStairs(levels, bounds, 25);
+  // Consecutive trajectories of the chain share a point, replicates are not filtered
+  CheckShards("winding stairs", windingStairs, false);
+
+  // The binary state restores the antithetic flag and leaves the stream after it
+  std::stringstream stream(std::ios::in | std::ios::out | std::ios::binary);
+  antithetic.saveBinary(stream);
+  const std::uint64_t marker = 0x4d6f72726973;
+  stream.write(reinterpret_cast<const char *>(&marker), sizeof(marker));
+  Indices coarse(2);
+  coarse.fill(3, 0);
+  MorrisExperimentGrid restored(coarse, 2);
+  restored.loadBinary(stream);
+  std::uint64_t next = 0;
+  stream.read(reinterpret_cast<char *>(&next), sizeof(next));
+  std::cout << "restored grid: antithetic=" << restored.getAntithetic()
+            << ", trajectories=" << restored.getTrajectoryNumber()
+            << ", same design=" << (restored.generate(0, 1, 1234) == antithetic.generate(0, 1, 1234))
+            << ", stream position kept=" << (next == marker) << std::endl;
+
+  return 0;
+}
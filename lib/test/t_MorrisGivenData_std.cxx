@@ -0,0 +1,45 @@
+#include <iostream>
+
+// OT includes
+#include <openturns/OT.hxx>
+#include "otmorris/MorrisGivenData.hxx"
+
+using namespace OT;
+using namespace OTMORRIS;
+
+int main(void)
+{
+  // On a regular 5x5 grid the nearest aligned neighbours are exact one-at-a-time moves
+  const UnsignedInteger levels = 5;
+  Sample inputSample(levels * levels, 2);
+  for (UnsignedInteger i = 0; i < levels; ++i)
+    for (UnsignedInteger j = 0; j < levels; ++j)
+    {
+      inputSample(i * levels + j, 0) = 1.0 * i;
+      inputSample(i * levels + j, 1) = 0.25 * j;
+    }
+  Description inputDescription(2);
+  inputDescription[0] = "x0";
+  inputDescription[1] = "x1";
+  const SymbolicFunction model(inputDescription, Description(1, "2 * x0 - 3 * x1"));
+  const Sample outputSample(model(inputSample));
+  // Effects are given in the unit cube, the domain being of width 4 along x0
+  Point upperBound(2, 1.0);
+  upperBound[0] = 4.0;
+  const MorrisGivenData givenData(inputSample, outputSample, Interval(Point(2, 0.0), upperBound), 6, 0.99);
+  const Indices pairNumber(givenData.getPairNumber());
+  std::cout << "pairs along each input=" << ((pairNumber[0] > 0) && (pairNumber[1] > 0) ? "true" : "false") << std::endl;
+  std::cout << "mean effects=" << givenData.getMeanElementaryEffects() << std::endl;
+  std::cout << "mean absolute effects=" << givenData.getMeanAbsoluteElementaryEffects() << std::endl;
+  std::cout << "standard deviation of the effects=" << givenData.getStandardDeviationElementaryEffects() << std::endl;
+  // Each pair moves along its input only
+  Bool aligned = true;
+  for (UnsignedInteger input = 0; input < 2; ++input)
+  {
+    const Indices pairs(givenData.getPairs(input));
+    for (UnsignedInteger k = 0; k < pairs.getSize(); k += 2)
+      aligned = aligned && (inputSample(pairs[k], 1 - input) == inputSample(pairs[k + 1], 1 - input));
+  }
+  std::cout << "aligned pairs=" << (aligned ? "true" : "false") << std::endl;
+  return 0;
+}
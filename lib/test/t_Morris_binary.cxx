@@ -0,0 +1,72 @@
+#include <iostream>
+#include <sstream>
+
+// OT includes
+#include <openturns/OT.hxx>
+#include "otmorris/Morris.hxx"
+
+using namespace OT;
+using namespace OTMORRIS;
+
+int main(void)
+{
+  std::cout << std::boolalpha;
+  // Three trajectories of a 3-level grid in [0,2]^3, each step moving one input
+  const Scalar points[12][3] = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {1, 1, 1},
+    {2, 2, 2}, {2, 1, 2}, {1, 1, 2}, {1, 1, 1},
+    {0, 2, 0}, {0, 2, 1}, {1, 2, 1}, {1, 1, 1}
+  };
+  Sample inputSample(12, 3);
+  for (UnsignedInteger i = 0; i < 12; ++i)
+    for (UnsignedInteger j = 0; j < 3; ++j)
+      inputSample(i, j) = points[i][j];
+  Description inputDescription(3);
+  inputDescription[0] = "a";
+  inputDescription[1] = "b";
+  inputDescription[2] = "c";
+  inputSample.setDescription(inputDescription);
+  Description formula(2);
+  formula[0] = "a + 2 * b - c";
+  formula[1] = "3 * a + b + c";
+  const SymbolicFunction model(inputDescription, formula);
+  const Sample outputSample(model(inputSample));
+  const Interval bounds(Point(3, 0.0), Point(3, 2.0));
+  const Morris morris(inputSample, outputSample, bounds);
+  std::cout << "trajectories=" << morris.getTrajectoryNumber() << std::endl;
+  std::cout << "mean effects=" << morris.getMeanElementaryEffects(0) << " " << morris.getMeanElementaryEffects(1) << std::endl;
+
+  // File round trip, the samples being read on first access
+  morris.saveBinary("t_Morris_binary.bin");
+  const Morris fromFile(Morris::LoadBinary("t_Morris_binary.bin"));
+  std::cout << "file: trajectories=" << fromFile.getTrajectoryNumber()
+            << ", mean effects=" << fromFile.getMeanElementaryEffects(0) << " " << fromFile.getMeanElementaryEffects(1) << std::endl;
+  std::cout << "file: samples restored=" << ((fromFile.getInputSample() == inputSample) && (fromFile.getOutputSample() == outputSample))
+            << ", description=" << fromFile.getInputSample().getDescription() << std::endl;
+
+  // Stream round trip, as used by pickling, with input and output dimensions above 1
+  std::stringstream stream(std::ios::in | std::ios::out | std::ios::binary);
+  morris.saveBinary(stream);
+  const Morris fromStream(Morris::LoadBinary(stream));
+  std::cout << "stream: trajectories=" << fromStream.getTrajectoryNumber()
+            << ", mean effects=" << fromStream.getMeanElementaryEffects(0) << " " << fromStream.getMeanElementaryEffects(1) << std::endl;
+  std::cout << "stream: samples restored=" << ((fromStream.getInputSample() == inputSample) && (fromStream.getOutputSample() == outputSample))
+            << ", description=" << fromStream.getInputSample().getDescription() << std::endl;
+
+  // Statistics only
+  std::stringstream statistics(std::ios::in | std::ios::out | std::ios::binary);
+  morris.saveBinary(statistics, false);
+  const Morris statisticsOnly(Morris::LoadBinary(statistics));
+  std::cout << "statistics only: trajectories=" << statisticsOnly.getTrajectoryNumber()
+            << ", mean effects=" << statisticsOnly.getMeanElementaryEffects(0) << std::endl;
+  try
+  {
+    statisticsOnly.getElementaryEffects();
+    std::cout << "statistics only: elementary effects computed" << std::endl;
+  }
+  catch (const InvalidArgumentException &)
+  {
+    std::cout << "statistics only: elementary effects need the samples" << std::endl;
+  }
+
+  return 0;
+}
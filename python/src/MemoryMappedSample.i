@@ -0,0 +1,13 @@
+// SWIG file
+
+%{
+#include "otmorris/MemoryMappedSample.hxx"
+%}
+
+%include MemoryMappedSample_doc.i
+
+%ignore OTMORRIS::MemoryMappedSample::data;
+%ignore OTMORRIS::MemoryMappedSample::singlePrecisionData;
+
+%include otmorris/MemoryMappedSample.hxx
+namespace OTMORRIS { %extend MemoryMappedSample { MemoryMappedSample(const MemoryMappedSample & other) { return new OTMORRIS::MemoryMappedSample(other); } } }
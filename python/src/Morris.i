@@ -6,9 +6,43 @@
 
 %include Morris_doc.i
 
+%thread OTMORRIS::Morris::Morris;
+%thread OTMORRIS::Morris::add;
+%thread OTMORRIS::Morris::extend;
+%thread OTMORRIS::Morris::saveBinary;
+%thread OTMORRIS::Morris::LoadBinary;
+%thread OTMORRIS::Morris::computePermutationPValues;
+%thread OTMORRIS::Morris::computeThresholdAnalysis;
+%thread OTMORRIS::Morris::computeStandardRegressionCoefficients;
+%thread OTMORRIS::Morris::computeRegressionDetermination;
+
 %include otmorris/Morris.hxx
 namespace OTMORRIS { %extend Morris { Morris(const Morris & other) { return new OTMORRIS::Morris(other); } } }
 
+namespace OTMORRIS { %extend Morris {
+
+PyObject * _getBinaryState() const
+{
+  std::ostringstream stream(std::ios::out | std::ios::binary);
+  self->saveBinary(stream);
+  return OTMORRIS_BinaryStateToBytes(stream);
+}
+
+static Morris _FromBinaryState(PyObject * state)
+{
+  std::istringstream stream(OTMORRIS_BytesToBinaryState(state), std::ios::in | std::ios::binary);
+  return OTMORRIS::Morris::LoadBinary(stream);
+}
+
+%pythoncode %{
+def __getstate__(self):
+    return self._getBinaryState()
+
+def __setstate__(self, state):
+    self.__init__(Morris._FromBinaryState(state))
+%}
+} }
+
 %pythoncode %{
 
 import openturns as ot
@@ -0,0 +1,12 @@
+// SWIG file
+
+%{
+#include "otmorris/MorrisBudgetPlanner.hxx"
+%}
+
+%include MorrisBudgetPlanner_doc.i
+
+%thread OTMORRIS::MorrisBudgetPlanner::measureEvaluationCost;
+
+%include otmorris/MorrisBudgetPlanner.hxx
+namespace OTMORRIS { %extend MorrisBudgetPlanner { MorrisBudgetPlanner(const MorrisBudgetPlanner & other) { return new OTMORRIS::MorrisBudgetPlanner(other); } } }
@@ -0,0 +1,12 @@
+// SWIG file
+
+%{
+#include "otmorris/MorrisDesignDiagnostics.hxx"
+%}
+
+%include MorrisDesignDiagnostics_doc.i
+
+%thread OTMORRIS::MorrisDesignDiagnostics::MorrisDesignDiagnostics;
+
+%include otmorris/MorrisDesignDiagnostics.hxx
+namespace OTMORRIS { %extend MorrisDesignDiagnostics { MorrisDesignDiagnostics(const MorrisDesignDiagnostics & other) { return new OTMORRIS::MorrisDesignDiagnostics(other); } } }
@@ -2,6 +2,26 @@
 
 %{
 #include "otmorris/MorrisExperiment.hxx"
+#include <sstream>
+
+// Binary states of the pickling support, as Python bytes
+PyObject * OTMORRIS_BinaryStateToBytes(const std::ostringstream & stream)
+{
+  const std::string state(stream.str());
+  return PyBytes_FromStringAndSize(state.data(), state.size());
+}
+
+std::string OTMORRIS_BytesToBinaryState(PyObject * bytes)
+{
+  char * buffer = 0;
+  Py_ssize_t length = 0;
+  if (PyBytes_AsStringAndSize(bytes, &buffer, &length) < 0)
+  {
+    PyErr_Clear();
+    throw OT::InvalidArgumentException(HERE) << "The state should be a bytes object";
+  }
+  return std::string(buffer, length);
+}
 %}
 
 %include MorrisExperiment_doc.i
@@ -10,3 +30,67 @@
 
 %include otmorris/MorrisExperiment.hxx
 namespace OTMORRIS { %extend MorrisExperiment { MorrisExperiment(const MorrisExperiment & other) { return new OTMORRIS::MorrisExperiment(other); } } }
+
+namespace OTMORRIS { %extend MorrisExperiment {
+
+PyObject * _getBinaryState() const
+{
+  std::ostringstream stream(std::ios::out | std::ios::binary);
+  self->saveBinary(stream);
+  return OTMORRIS_BinaryStateToBytes(stream);
+}
+
+%pythoncode %{
+def __getstate__(self):
+    return self._getBinaryState()
+
+def trajectories(self, batch=64, seed=None):
+    """
+    Generate the trajectories lazily, by blocks.
+
+    Parameters
+    ----------
+    batch : int, optional
+        Maximum number of trajectories of a block, default is 64
+    seed : int, optional
+        Seed of the reproducible design. By default, it is drawn from
+        :py:class:`openturns.RandomGenerator`.
+
+    Returns
+    -------
+    blocks : generator of :class:`numpy.ndarray`
+        Blocks of shape :math:`(n, p+1, p)` with :math:`n \\leq batch`
+
+    Notes
+    -----
+    Block `i` out of `nb` is the shard `generate(i, nb, seed)` of the
+    reproducible design, with `nb` the least number of blocks of at most
+    `batch` trajectories: only one block is held in memory at a time.
+    Its first trajectory is the trajectory :math:`\\lfloor iN/nb \\rfloor`
+    of the design, which is the index expected by
+    :meth:`~otmorris.Morris.addResult` with ``Morris(experiment, seed, q)``.
+
+    Examples
+    --------
+    >>> import otmorris
+    >>> experiment = otmorris.MorrisExperimentGrid([5] * 3, 10)
+    >>> for block in experiment.trajectories(4, seed=42):
+    ...     print(block.shape)
+    (3, 4, 3)
+    (3, 4, 3)
+    (4, 4, 3)
+    """
+    import numpy as np
+    import openturns as ot
+    if batch < 1:
+        raise ValueError('batch should be positive')
+    if seed is None:
+        seed = int(ot.RandomGenerator.IntegerGenerate(1, 2 ** 31 - 1)[0])
+    N = self.getTrajectoryNumber()
+    dimension = self.getBounds().getDimension()
+    blockNumber = (N + batch - 1) // batch
+    for i in range(blockNumber):
+        sample = np.array(self.generate(i, blockNumber, seed))
+        yield sample.reshape(-1, dimension + 1, dimension)
+%}
+} }
@@ -6,5 +6,25 @@
 
 %include MorrisExperimentGrid_doc.i
 
+%thread OTMORRIS::MorrisExperimentGrid::generate;
+%thread OTMORRIS::MorrisExperimentGrid::generateToFile;
+
 %include otmorris/MorrisExperimentGrid.hxx
 namespace OTMORRIS { %extend MorrisExperimentGrid { MorrisExperimentGrid(const MorrisExperimentGrid & other) { return new OTMORRIS::MorrisExperimentGrid(other); } } }
+
+namespace OTMORRIS { %extend MorrisExperimentGrid {
+
+static MorrisExperimentGrid _FromBinaryState(PyObject * state)
+{
+  std::istringstream stream(OTMORRIS_BytesToBinaryState(state), std::ios::in | std::ios::binary);
+  // Placeholder parameters, overwritten by the state
+  OTMORRIS::MorrisExperimentGrid experiment(OT::Indices(1, 3), 1);
+  experiment.loadBinary(stream);
+  return experiment;
+}
+
+%pythoncode %{
+def __setstate__(self, state):
+    self.__init__(MorrisExperimentGrid._FromBinaryState(state))
+%}
+} }
@@ -8,5 +8,25 @@
 
 %template(MorrisExperimentLHSdInterfaceObject)           OT::TypedInterfaceObject<OTMORRIS::MorrisExperimentLHS>;
 
+%thread OTMORRIS::MorrisExperimentLHS::generate;
+%thread OTMORRIS::MorrisExperimentLHS::generateToFile;
+
 %include otmorris/MorrisExperimentLHS.hxx
 namespace OTMORRIS { %extend MorrisExperimentLHS { MorrisExperimentLHS(const MorrisExperimentLHS & other) { return new OTMORRIS::MorrisExperimentLHS(other); } } }
+
+namespace OTMORRIS { %extend MorrisExperimentLHS {
+
+static MorrisExperimentLHS _FromBinaryState(PyObject * state)
+{
+  std::istringstream stream(OTMORRIS_BytesToBinaryState(state), std::ios::in | std::ios::binary);
+  // Placeholder parameters, overwritten by the state
+  OTMORRIS::MorrisExperimentLHS experiment(OT::Sample(1, 1), 1);
+  experiment.loadBinary(stream);
+  return experiment;
+}
+
+%pythoncode %{
+def __setstate__(self, state):
+    self.__init__(MorrisExperimentLHS._FromBinaryState(state))
+%}
+} }
@@ -0,0 +1,29 @@
+// SWIG file
+
+%{
+#include "otmorris/MorrisExperimentWindingStairs.hxx"
+%}
+
+%include MorrisExperimentWindingStairs_doc.i
+
+%thread OTMORRIS::MorrisExperimentWindingStairs::generate;
+
+%include otmorris/MorrisExperimentWindingStairs.hxx
+namespace OTMORRIS { %extend MorrisExperimentWindingStairs { MorrisExperimentWindingStairs(const MorrisExperimentWindingStairs & other) { return new OTMORRIS::MorrisExperimentWindingStairs(other); } } }
+
+namespace OTMORRIS { %extend MorrisExperimentWindingStairs {
+
+static MorrisExperimentWindingStairs _FromBinaryState(PyObject * state)
+{
+  std::istringstream stream(OTMORRIS_BytesToBinaryState(state), std::ios::in | std::ios::binary);
+  // Placeholder parameters, overwritten by the state
+  OTMORRIS::MorrisExperimentWindingStairs experiment(OT::Indices(1, 3), 1);
+  experiment.loadBinary(stream);
+  return experiment;
+}
+
+%pythoncode %{
+def __setstate__(self, state):
+    self.__init__(MorrisExperimentWindingStairs._FromBinaryState(state))
+%}
+} }
@@ -0,0 +1,12 @@
+// SWIG file
+
+%{
+#include "otmorris/MorrisGivenData.hxx"
+%}
+
+%include MorrisGivenData_doc.i
+
+%thread OTMORRIS::MorrisGivenData::MorrisGivenData;
+
+%include otmorris/MorrisGivenData.hxx
+namespace OTMORRIS { %extend MorrisGivenData { MorrisGivenData(const MorrisGivenData & other) { return new OTMORRIS::MorrisGivenData(other); } } }
@@ -0,0 +1,12 @@
+// SWIG file
+
+%{
+#include "otmorris/MorrisRegionalAnalysis.hxx"
+%}
+
+%include MorrisRegionalAnalysis_doc.i
+
+%thread OTMORRIS::MorrisRegionalAnalysis::MorrisRegionalAnalysis;
+
+%include otmorris/MorrisRegionalAnalysis.hxx
+namespace OTMORRIS { %extend MorrisRegionalAnalysis { MorrisRegionalAnalysis(const MorrisRegionalAnalysis & other) { return new OTMORRIS::MorrisRegionalAnalysis(other); } } }
@@ -0,0 +1,61 @@
+// SWIG file
+
+%{
+#include "otmorris/MorrisRun.hxx"
+%}
+
+%include MorrisRun_doc.i
+
+// Waiting for the background thread, which may need the GIL to evaluate Python models
+%thread OTMORRIS::MorrisRun::wait;
+%thread OTMORRIS::MorrisRun::getResult;
+%thread OTMORRIS::MorrisRun::~MorrisRun;
+
+%include otmorris/MorrisRun.hxx
+namespace OTMORRIS { %extend MorrisRun { MorrisRun(const MorrisRun & other) { return new OTMORRIS::MorrisRun(other); } } }
+
+namespace OTMORRIS { %extend MorrisRun {
+
+%pythoncode %{
+def future(self):
+    """
+    Future of the final result.
+
+    Returns
+    -------
+    future : :class:`concurrent.futures.Future`
+        Future resolved with the final :class:`~otmorris.Morris` object
+
+    Notes
+    -----
+    The future is resolved by a helper thread waiting for the run. Use
+    :meth:`cancel` to stop the run, as the future itself is already running.
+    In asyncio code, it can be awaited through :func:`asyncio.wrap_future`.
+
+    Examples
+    --------
+    >>> import openturns as ot
+    >>> import otmorris
+    >>> experiment = otmorris.MorrisExperimentGrid([5] * 2, 10)
+    >>> model = ot.SymbolicFunction(['x', 'y'], ['x + 2 * y'])
+    >>> future = otmorris.MorrisRun(experiment, model).future()
+    >>> print(future.result().getMeanElementaryEffects())
+    [1,2]
+    """
+    import concurrent.futures
+    import threading
+    future = concurrent.futures.Future()
+    future.set_running_or_notify_cancel()
+    run = MorrisRun(self)
+
+    def resolve():
+        try:
+            future.set_result(run.getResult())
+        except Exception as exception:
+            future.set_exception(exception)
+    thread = threading.Thread(target=resolve)
+    thread.daemon = True
+    thread.start()
+    return future
+%}
+} }
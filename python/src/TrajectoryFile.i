@@ -0,0 +1,9 @@
+// SWIG file
+
+%{
+#include "otmorris/TrajectoryFile.hxx"
+%}
+
+%include TrajectoryFile_doc.i
+
+%include otmorris/TrajectoryFile.hxx
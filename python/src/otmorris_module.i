@@ -1,6 +1,9 @@
 // SWIG file otmorris_module.i
 
-%module(docstring="otmorris module") otmorris
+%module(docstring="otmorris module", threads="1") otmorris
+
+// The GIL is only released around the long-running calls marked with %thread
+%nothread;
 
 %{
 #include <openturns/OT.hxx>
@@ -18,8 +21,16 @@
 
 // The new classes
 %include otmorris/OTMORRISprivate.hxx
+%include MemoryMappedSample.i
+%include TrajectoryFile.i
 %include MorrisExperiment.i
 %include MorrisExperimentGrid.i
 %include MorrisExperimentLHS.i
+%include MorrisExperimentWindingStairs.i
+%include MorrisDesignDiagnostics.i
+%include MorrisBudgetPlanner.i
 %include Morris.i
+%include MorrisRun.i
+%include MorrisRegionalAnalysis.i
+%include MorrisGivenData.i
 
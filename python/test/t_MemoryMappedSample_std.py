@@ -0,0 +1,57 @@
+#!/usr/bin/env python
+
+from __future__ import print_function
+import os
+import tempfile
+import numpy as np
+import openturns as ot
+import openturns.testing as ott
+import otmorris
+
+ot.RandomGenerator.SetSeed(0)
+dim = 4
+bounds = ot.Interval([-1.0] * dim, [2.0] * dim)
+experiment = otmorris.MorrisExperimentGrid([5] * dim, bounds, 10)
+X = experiment.generate()
+model = ot.SymbolicFunction(['x0', 'x1', 'x2', 'x3'],
+                            ['x0 + 2 * x1 * x2 + sin(x3)', 'x0 * x3 - x1'])
+Y = model(X)
+reference = otmorris.Morris(X, Y, bounds)
+
+work_dir = tempfile.mkdtemp()
+# .npy files
+np.save(os.path.join(work_dir, 'X.npy'), np.array(X))
+np.save(os.path.join(work_dir, 'Y.npy'), np.array(Y))
+mX = otmorris.MemoryMappedSample(os.path.join(work_dir, 'X.npy'))
+mY = otmorris.MemoryMappedSample(os.path.join(work_dir, 'Y.npy'))
+assert mX.getSize() == X.getSize() and mX.getDimension() == dim
+ott.assert_almost_equal(mX.getSample(0, X.getSize()), X, 0.0, 0.0)
+morris = otmorris.Morris(mX, mY, bounds)
+for marginal in range(2):
+    ott.assert_almost_equal(morris.getMeanElementaryEffects(marginal),
+                            reference.getMeanElementaryEffects(marginal))
+    ott.assert_almost_equal(morris.getMeanAbsoluteElementaryEffects(marginal),
+                            reference.getMeanAbsoluteElementaryEffects(marginal))
+    ott.assert_almost_equal(morris.getStandardDeviationElementaryEffects(marginal),
+                            reference.getStandardDeviationElementaryEffects(marginal))
+
+# raw files
+np.array(X).tofile(os.path.join(work_dir, 'X.bin'))
+np.array(Y).tofile(os.path.join(work_dir, 'Y.bin'))
+mX = otmorris.MemoryMappedSample(os.path.join(work_dir, 'X.bin'), dim)
+mY = otmorris.MemoryMappedSample(os.path.join(work_dir, 'Y.bin'), 2)
+morris = otmorris.Morris(mX, mY, bounds)
+ott.assert_almost_equal(morris.getMeanAbsoluteElementaryEffects(1),
+                        reference.getMeanAbsoluteElementaryEffects(1))
+# the trajectories are not kept
+assert morris.getInputSample().getSize() == 0
+for query in [lambda: morris.getElementaryEffects(0),
+              lambda: morris.computePermutationPValues(9),
+              lambda: morris.computeThresholdAnalysis([0.0]),
+              lambda: morris.computeStandardRegressionCoefficients()]:
+    try:
+        query()
+        raise AssertionError('sample-based query should fail on mapped files')
+    except (TypeError, ValueError):
+        pass
+del mX, mY, morris
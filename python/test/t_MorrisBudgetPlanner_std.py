@@ -0,0 +1,72 @@
+#!/usr/bin/env python
+
+from __future__ import print_function
+import openturns as ot
+import otmorris
+
+dim = 5
+experiment = otmorris.MorrisExperimentGrid([4] * dim, 2)
+fullDesignSize = 2 * 3 ** dim
+assert experiment.getFullDesignSize() == fullDesignSize
+planner = otmorris.MorrisBudgetPlanner(experiment, 2)
+print(planner)
+assert planner.getFullDesignSize() == fullDesignSize
+
+# predictions
+N = 10
+assert planner.computeEvaluationNumber(N) == N * (dim + 1)
+assert planner.computeDesignMemory(N) == N * (dim + 1) * dim * 8
+assert planner.computeOutputMemory(N) == N * (dim + 1) * 2 * 8
+assert planner.computeEffectsMemory(N) == N * dim * 2 * 8
+assert planner.computeMemory(N) == planner.computeDesignMemory(N) + planner.computeOutputMemory(N) + planner.computeEffectsMemory(N)
+planner.setEvaluationCost(0.25)
+planner.setWorkerNumber(4)
+assert abs(planner.computeWallTime(N) - 15 * 0.25) < 1e-12
+
+# the largest number of trajectories fits each budget, one more does not
+for budget in ['evaluation', 'time', 'memory']:
+    planner.setEvaluationBudget(100 if budget == 'evaluation' else 0)
+    planner.setTimeBudget(10.0 if budget == 'time' else 0.0)
+    planner.setMemoryBudget(20000 if budget == 'memory' else 0)
+    N = planner.computeLargestTrajectoryNumber()
+    print(budget, N)
+    assert planner.isFeasible(N) and not planner.isFeasible(N + 1)
+assert planner.computeLargestTrajectoryNumber() == 48
+
+# without budget, the full design size is the limit, and larger designs are rejected
+planner.setMemoryBudget(0)
+assert planner.computeLargestTrajectoryNumber() == fullDesignSize
+planner.checkTrajectoryNumber(fullDesignSize)
+try:
+    planner.checkTrajectoryNumber(fullDesignSize + 1)
+    raise AssertionError('designs larger than the full design size should be rejected')
+except (TypeError, ValueError):
+    pass
+assert not planner.isFeasible(fullDesignSize + 1)
+
+# antithetic designs come by pairs
+experiment.setAntithetic(True)
+pairs = otmorris.MorrisBudgetPlanner(experiment, 2)
+pairs.setEvaluationBudget(100)
+assert pairs.computeLargestTrajectoryNumber() == 16
+assert not pairs.isFeasible(15)
+
+# winding stairs share a point between consecutive trajectories, and have no size limit
+stairs = otmorris.MorrisBudgetPlanner(otmorris.MorrisExperimentWindingStairs([4] * dim, 2))
+stairs.setEvaluationBudget(101)
+assert stairs.computeLargestTrajectoryNumber() == 20
+assert stairs.computeEvaluationNumber(20) == 101
+try:
+    otmorris.MorrisBudgetPlanner(otmorris.MorrisExperimentWindingStairs([4] * dim, 2)).computeLargestTrajectoryNumber()
+    raise AssertionError('an unlimited design needs a budget')
+except (TypeError, ValueError):
+    pass
+
+# LHS designs are limited by their size
+lhs = otmorris.MorrisExperimentLHS(ot.LHSExperiment(ot.ComposedDistribution([ot.Uniform(0.0, 1.0)] * dim), 20).generate(), 2)
+assert otmorris.MorrisBudgetPlanner(lhs).getFullDesignSize() == 20 * dim
+
+# pilot timing
+model = ot.SymbolicFunction(['x0', 'x1', 'x2', 'x3', 'x4'], ['x0 + x1 * x2', 'sin(x3) * x4'])
+cost = planner.measureEvaluationCost(model, 50)
+assert cost >= 0.0 and planner.getEvaluationCost() == cost
@@ -0,0 +1,73 @@
+#!/usr/bin/env python
+
+from __future__ import print_function
+import openturns as ot
+import otmorris
+import numpy as np
+
+ot.RandomGenerator.SetSeed(0)
+dim = 4
+bounds = ot.Interval([-1.0] * dim, [3.0] * dim)
+experiment = otmorris.MorrisExperimentGrid([5] * dim, bounds, 30)
+design = experiment.generate()
+diagnostics = otmorris.MorrisDesignDiagnostics(design, bounds, 5)
+print(diagnostics)
+assert diagnostics.getTrajectoryNumber() == 30
+
+# brute-force references in the unit cube
+u = (np.array(design) + 1.0) / 4.0
+trajectories = u.reshape(30, dim + 1, dim)
+centroids = trajectories.mean(axis=1)
+distances = np.sqrt(((centroids[:, None, :] - centroids[None, :, :]) ** 2).sum(axis=2))
+upper = distances[np.triu_indices(30, 1)]
+np.fill_diagonal(distances, np.inf)
+assert np.allclose(diagnostics.getNearestTrajectoryDistance(), distances.min(axis=1))
+assert abs(diagnostics.getMinimumTrajectoryDistance() - distances.min()) < 1e-12
+assert abs(diagnostics.getMeanTrajectoryDistance() - upper.mean()) < 1e-12
+
+z = trajectories[:, 0, :] - 0.5
+rowTerm = np.prod(1.0 + 0.5 * np.abs(z) - 0.5 * z ** 2, axis=1).sum()
+pairTerm = np.prod(1.0 + 0.5 * np.abs(z[:, None, :]) + 0.5 * np.abs(z[None, :, :]) - 0.5 * np.abs(z[:, None, :] - z[None, :, :]), axis=2).sum()
+discrepancy = np.sqrt((13.0 / 12.0) ** dim - 2.0 * rowTerm / 30 + pairTerm / 30 ** 2)
+assert abs(diagnostics.getBaseDiscrepancy() - discrepancy) < 1e-10
+
+# the grid levels fall into distinct bins
+histogram = np.array(diagnostics.getLevelHistogram())
+assert histogram.shape == (dim, 5)
+assert np.all(histogram.sum(axis=1) == 30 * (dim + 1))
+for k in range(dim):
+    assert np.array_equal(histogram[k], [np.sum(np.isclose(u[:, k], level / 4.0)) for level in range(5)])
+assert np.allclose(diagnostics.getLevelCoverage(), (histogram > 0).mean(axis=1))
+
+_, inverse, counts = np.unique(u, axis=0, return_inverse=True, return_counts=True)
+assert abs(diagnostics.getDuplicateFraction() - np.mean(counts[inverse.ravel()] > 1)) < 1e-12
+
+# a design repeated twice only holds duplicates
+twice = ot.Sample(design)
+twice.add(design)
+assert otmorris.MorrisDesignDiagnostics(twice, bounds, 5).getDuplicateFraction() == 1.0
+
+# constructor from the experiment
+diagnostics = otmorris.MorrisDesignDiagnostics(otmorris.MorrisExperimentLHS(20, bounds, 10), 20)
+assert diagnostics.getTrajectoryNumber() == 10
+
+# winding stairs chains: trajectories start every dim points
+stairs = otmorris.MorrisExperimentWindingStairs([5] * dim, bounds, 12)
+chain = stairs.generate()
+assert chain.getSize() == 12 * dim + 1
+for diagnostics in [otmorris.MorrisDesignDiagnostics(chain, bounds, 5),
+                    otmorris.MorrisDesignDiagnostics(stairs, 5)]:
+    assert diagnostics.getTrajectoryNumber() == 12
+u = (np.array(chain) + 1.0) / 4.0
+trajectories = np.array([u[n * dim:n * dim + dim + 1] for n in range(12)])
+centroids = trajectories.mean(axis=1)
+distances = np.sqrt(((centroids[:, None, :] - centroids[None, :, :]) ** 2).sum(axis=2))
+np.fill_diagonal(distances, np.inf)
+diagnostics = otmorris.MorrisDesignDiagnostics(chain, bounds, 5)
+assert np.allclose(diagnostics.getNearestTrajectoryDistance(), distances.min(axis=1))
+z = trajectories[:, 0, :] - 0.5
+rowTerm = np.prod(1.0 + 0.5 * np.abs(z) - 0.5 * z ** 2, axis=1).sum()
+pairTerm = np.prod(1.0 + 0.5 * np.abs(z[:, None, :]) + 0.5 * np.abs(z[None, :, :]) - 0.5 * np.abs(z[:, None, :] - z[None, :, :]), axis=2).sum()
+discrepancy = np.sqrt((13.0 / 12.0) ** dim - 2.0 * rowTerm / 12 + pairTerm / 12 ** 2)
+assert abs(diagnostics.getBaseDiscrepancy() - discrepancy) < 1e-10
+assert np.all(np.array(diagnostics.getLevelHistogram()).sum(axis=1) == 12 * dim + 1)
@@ -0,0 +1,78 @@
+#!/usr/bin/env python
+
+from __future__ import print_function
+import openturns as ot
+import openturns.testing as ott
+import otmorris
+import numpy as np
+import pickle
+
+ot.RandomGenerator.SetSeed(0)
+dim = 4
+N = 40
+bounds = ot.Interval([-1.0] * dim, [3.0] * dim)
+experiment = otmorris.MorrisExperimentGrid([5] * dim, bounds, N)
+assert not experiment.getAntithetic()
+experiment.setAntithetic(True)
+assert experiment.getAntithetic()
+X = np.array(experiment.generate())
+assert X.shape == (N * (dim + 1), dim)
+
+# trajectory 2m+1 is the mirror of trajectory 2m
+T = X.reshape(N, dim + 1, dim)
+center = -1.0 + 3.0
+for m in range(N // 2):
+    assert np.allclose(T[2 * m + 1], center - T[2 * m])
+
+# shards cover the same design whatever their number
+full = np.array(experiment.generate(0, 1, 7))
+parts = [np.array(experiment.generate(s, 3, 7)) for s in range(3)]
+assert np.allclose(full, np.vstack(parts))
+
+# a mirror never replicates another trajectory, even on a coarse grid
+coarse = otmorris.MorrisExperimentGrid([5] * 2, 6)
+coarse.setAntithetic(True)
+for design in [coarse.generate(), np.vstack([np.array(coarse.generate(s, 3, 7)) for s in range(3)])]:
+    trajectories = np.array(design).reshape(6, 3 * 2)
+    assert len(np.unique(trajectories, axis=0)) == 6
+
+# odd numbers of trajectories are rejected
+for action in [lambda: experiment.setTrajectoryNumber(N + 1), lambda: otmorris.MorrisExperimentGrid([5] * dim, N + 1).setAntithetic(True)]:
+    try:
+        action()
+        raise AssertionError('an odd number of trajectories should be rejected')
+    except (TypeError, ValueError):
+        pass
+
+# the flag survives pickling
+copy = pickle.loads(pickle.dumps(experiment))
+assert copy.getAntithetic()
+
+# standard errors match the per-trajectory effects
+model = ot.SymbolicFunction(['x0', 'x1', 'x2', 'x3'], ['x0 + 2 * x1 + 0.1 * x2^3 - x3 + 0.05 * x0 * x2'])
+ot.RandomGenerator.SetSeed(1)
+morris = otmorris.Morris(experiment, model)
+ee = np.array(morris.getElementaryEffects())
+assert ee.shape == (N, dim)
+ott.assert_almost_equal(ee.mean(axis=0), morris.getMeanElementaryEffects(), 1e-10, 1e-10)
+ott.assert_almost_equal(np.abs(ee).mean(axis=0), morris.getMeanAbsoluteElementaryEffects(), 1e-10, 1e-10)
+ott.assert_almost_equal(ee.std(axis=0, ddof=1) / np.sqrt(N), morris.getMeanElementaryEffectsStandardError(), 1e-10, 1e-10)
+pairs = ee.reshape(N // 2, 2, dim).mean(axis=1)
+ott.assert_almost_equal(pairs.std(axis=0, ddof=1) / np.sqrt(N // 2), morris.getMeanElementaryEffectsStandardError(0, 2), 1e-10, 1e-10)
+absPairs = np.abs(ee).reshape(N // 2, 2, dim).mean(axis=1)
+ott.assert_almost_equal(absPairs.std(axis=0, ddof=1) / np.sqrt(N // 2), morris.getMeanAbsoluteElementaryEffectsStandardError(0, 2), 1e-10, 1e-10)
+
+# for this nearly monotone model, the pairs reduce the standard error of x2 whose effect is not constant
+plain = otmorris.MorrisExperimentGrid([5] * dim, bounds, N)
+ot.RandomGenerator.SetSeed(1)
+reference = otmorris.Morris(plain, model)
+print('antithetic', morris.getMeanElementaryEffectsStandardError(0, 2))
+print('plain', reference.getMeanElementaryEffectsStandardError())
+assert morris.getMeanElementaryEffectsStandardError(0, 2)[2] < reference.getMeanElementaryEffectsStandardError()[2]
+
+# group sizes should divide the number of trajectories
+try:
+    morris.getMeanElementaryEffectsStandardError(0, 3)
+    raise AssertionError('group size should divide the number of trajectories')
+except (TypeError, ValueError):
+    pass
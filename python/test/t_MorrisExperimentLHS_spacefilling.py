@@ -0,0 +1,29 @@
+#!/usr/bin/env python
+
+from __future__ import print_function
+import openturns as ot
+import otmorris
+import numpy as np
+
+dim = 5
+size = 40
+bounds = ot.Interval([0.0] * dim, [2.0] * dim)
+for criterion in ['maximin', 'C2']:
+    ot.RandomGenerator.SetSeed(0)
+    experiment = otmorris.MorrisExperimentLHS(size, bounds, 20, criterion)
+    design = np.array(experiment.generate())
+    assert design.shape == (20 * (dim + 1), dim)
+    # the points lie on the centered levels of the interval
+    levels = design / (2.0 / size) - 0.5
+    assert np.allclose(levels, np.round(levels))
+    assert levels.min() > -0.5 and levels.max() < size - 0.5
+    # the design only depends on the random generator state
+    ot.RandomGenerator.SetSeed(0)
+    other = otmorris.MorrisExperimentLHS(size, bounds, 20, criterion)
+    assert np.array_equal(np.array(experiment.generate(0, 1, 5)), np.array(other.generate(0, 1, 5)))
+
+try:
+    otmorris.MorrisExperimentLHS(size, bounds, 20, 'foo')
+    raise AssertionError('unknown criterion accepted')
+except Exception:
+    pass
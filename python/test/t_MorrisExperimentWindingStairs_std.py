@@ -0,0 +1,81 @@
+#!/usr/bin/env python
+
+from __future__ import print_function
+import openturns as ot
+import openturns.testing as ott
+import otmorris
+import numpy as np
+import pickle
+
+ot.RandomGenerator.SetSeed(0)
+dim = 4
+N = 25
+bounds = ot.Interval([-1.0] * dim, [3.0] * dim)
+experiment = otmorris.MorrisExperimentWindingStairs([5] * dim, bounds, N)
+assert experiment.getSize() == N * dim + 1
+assert experiment.getTrajectoryStride() == dim
+X = np.array(experiment.generate())
+assert X.shape == (N * dim + 1, dim)
+
+# each step moves the next factor by one level, on the grid
+steps = np.diff(X, axis=0)
+for s in range(N * dim):
+    moved = np.nonzero(steps[s])[0]
+    assert list(moved) == [s % dim]
+    assert abs(abs(steps[s, s % dim]) - 1.0) < 1e-12
+levels = (X + 1.0) / 1.0
+assert np.allclose(levels, np.round(levels)) and X.min() >= -1.0 and X.max() <= 3.0
+
+# same effects as the trajectories expanded from the chain, with fewer evaluations
+model = ot.SymbolicFunction(['x0', 'x1', 'x2', 'x3'], ['x0 * x1 + sin(x2) - x3', 'x0^2 + x3'])
+ot.RandomGenerator.SetSeed(1)
+morris = otmorris.Morris(experiment, model)
+assert morris.getTrajectoryNumber() == N
+ot.RandomGenerator.SetSeed(1)
+chain = experiment.generate()
+expanded = ot.Sample(0, dim)
+for k in range(N):
+    expanded.add(chain[k * dim:k * dim + dim + 1])
+reference = otmorris.Morris(expanded, model(expanded), bounds)
+for marginal in range(2):
+    ott.assert_almost_equal(morris.getMeanAbsoluteElementaryEffects(marginal), reference.getMeanAbsoluteElementaryEffects(marginal))
+    ott.assert_almost_equal(morris.getMeanElementaryEffects(marginal), reference.getMeanElementaryEffects(marginal))
+    ott.assert_almost_equal(morris.getStandardDeviationElementaryEffects(marginal), reference.getStandardDeviationElementaryEffects(marginal))
+
+# shards return the trajectories of the reproducible chain as separate blocks
+full = np.array(experiment.generate(0, 1, 7))
+assert full.shape == (N * (dim + 1), dim)
+shards = np.concatenate([np.array(experiment.generate(i, 3, 7)) for i in range(3)])
+assert np.array_equal(full, shards)
+blocks = full.reshape(N, dim + 1, dim)
+assert np.array_equal(blocks[1:, 0], blocks[:-1, -1])
+
+# the last shard of a large chain only holds its own points, the previous moves being replayed
+large = otmorris.MorrisExperimentWindingStairs([5] * dim, bounds, 2000000)
+last = large.generate(199999, 200000, 7)
+assert last.getSize() == 10 * (dim + 1)
+before = np.array(large.generate(199998, 200000, 7))
+assert np.array_equal(before[-1], np.array(last)[0])
+assert np.array_equal(np.array(large.generate(0, 200000, 7)), full[:10 * (dim + 1)])
+
+# results added in any order
+morris = otmorris.Morris(experiment, 7, 2)
+for k in reversed(range(N)):
+    trajectory = experiment.generate(k, N, 7)
+    for i in range(dim + 1):
+        morris.addResult(k, i, model(trajectory[i]))
+reference = otmorris.Morris(ot.Sample(full), model(ot.Sample(full)), bounds)
+ott.assert_almost_equal(morris.getMeanAbsoluteElementaryEffects(), reference.getMeanAbsoluteElementaryEffects())
+
+# extend and background run
+morris = otmorris.Morris(experiment, model)
+morris.extend(experiment, model, 5)
+assert morris.getTrajectoryNumber() == N + 5
+run = otmorris.MorrisRun(experiment, model, 4)
+result = run.getResult()
+assert result.getTrajectoryNumber() == N
+assert run.getEvaluationNumber() == run.getTotalEvaluationNumber()
+
+copy = pickle.loads(pickle.dumps(experiment))
+assert copy.getSize() == experiment.getSize()
+assert copy.generate(0, 1, 3) == experiment.generate(0, 1, 3)
@@ -0,0 +1,33 @@
+#!/usr/bin/env python
+
+from __future__ import print_function
+import openturns as ot
+import openturns.testing as ott
+import otmorris
+
+dim = 4
+seed = 1234
+lhs = ot.LHSExperiment(ot.ComposedDistribution([ot.Uniform(0, 1)] * dim), 30, True, False).generate()
+# second LHS case reuses starting points (N > size)
+experiments = [otmorris.MorrisExperimentGrid([4] * dim, 50),
+               otmorris.MorrisExperimentGrid([2] * 2, 2),
+               otmorris.MorrisExperimentLHS(lhs, 20),
+               otmorris.MorrisExperimentLHS(lhs, 45)]
+for experiment in experiments:
+    ot.RandomGenerator.SetSeed(0)
+    full = experiment.generate(0, 1, seed)
+    # does not depend on the global generator
+    ot.RandomGenerator.SetSeed(77)
+    ott.assert_almost_equal(experiment.generate(0, 1, seed), full, 0.0, 0.0)
+    d = full.getDimension()
+    N = full.getSize() // (d + 1)
+    for shardCount in [2, 3, 7]:
+        shards = ot.Sample(0, d)
+        for shardIndex in range(shardCount):
+            shards.add(experiment.generate(shardIndex, shardCount, seed))
+        ott.assert_almost_equal(shards, full, 0.0, 0.0)
+    trajectories = set(tuple(full[k * (d + 1):(k + 1) * (d + 1)].asPoint()) for k in range(N))
+    assert len(trajectories) == N, 'replicated trajectories'
+    # another seed gives another design
+    if N > 2:
+        assert experiment.generate(0, 1, seed + 1) != full
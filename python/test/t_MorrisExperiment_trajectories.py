@@ -0,0 +1,41 @@
+#!/usr/bin/env python
+
+from __future__ import print_function
+import openturns as ot
+import otmorris
+import numpy as np
+
+ot.RandomGenerator.SetSeed(0)
+dim = 4
+bounds = ot.Interval([0.0] * dim, [2.0] * dim)
+lhsDesign = ot.LHSExperiment(ot.ComposedDistribution([ot.Uniform(0.0, 2.0)] * dim), 50).generate()
+experiments = [otmorris.MorrisExperimentGrid([6] * dim, bounds, 37),
+               otmorris.MorrisExperimentLHS(lhsDesign, bounds, 37)]
+model = ot.SymbolicFunction(['x0', 'x1', 'x2', 'x3'], ['x0 * x1 - x2 + x3^2'])
+seed = 11
+for experiment in experiments:
+    blocks = list(experiment.trajectories(batch=8, seed=seed))
+    assert len(blocks) == 5
+    assert all(block.shape[0] <= 8 and block.shape[1:] == (dim + 1, dim) for block in blocks)
+    # blocks are the reproducible design
+    full = np.concatenate(blocks).reshape(-1, dim)
+    assert np.array_equal(full, np.array(experiment.generate(0, 1, seed)))
+
+    # feed the outputs back incrementally
+    morris = otmorris.Morris(experiment, seed, 1)
+    first = 0
+    for block in experiment.trajectories(batch=8, seed=seed):
+        for k in range(block.shape[0]):
+            for i in range(dim + 1):
+                morris.addResult(first + k, i, model(block[k, i]))
+        first += block.shape[0]
+    assert morris.getTrajectoryNumber() == 37
+    reference = otmorris.Morris(ot.Sample(full), model(full), bounds)
+    assert np.allclose(morris.getMeanAbsoluteElementaryEffects(), reference.getMeanAbsoluteElementaryEffects())
+
+# the default seed comes from the random generator
+ot.RandomGenerator.SetSeed(3)
+a = next(experiments[0].trajectories())
+ot.RandomGenerator.SetSeed(3)
+b = next(experiments[0].trajectories())
+assert np.array_equal(a, b)
@@ -0,0 +1,47 @@
+#!/usr/bin/env python
+
+from __future__ import print_function
+import openturns as ot
+import otmorris
+import numpy as np
+
+# on a regular grid the nearest aligned neighbours are exact one-at-a-time moves
+levels = 5
+dim = 3
+grid = np.array(np.meshgrid(*[np.linspace(0.0, 2.0, levels)] * dim, indexing='ij')).reshape(dim, -1).T
+interval = ot.Interval([0.0] * dim, [2.0] * dim)
+model = ot.SymbolicFunction(['x0', 'x1', 'x2'], ['3 * x0 - x1 + 2 * x2', 'x0 * x1'])
+X = ot.Sample(grid)
+Y = model(X)
+givenData = otmorris.MorrisGivenData(X, Y, interval, 6, 0.99)
+print(givenData)
+assert list(givenData.getPairNumber()) == [(levels - 1) * levels ** (dim - 1)] * dim
+# effects are given in the unit cube, the domain being of width 2
+assert np.allclose(givenData.getMeanElementaryEffects(0), [6.0, -2.0, 4.0])
+assert np.allclose(givenData.getStandardDeviationElementaryEffects(0), [0.0] * dim)
+assert np.allclose(givenData.getMeanAbsoluteElementaryEffects(1)[2], 0.0)
+
+# random archive: statistics against a direct computation from the pairs
+ot.RandomGenerator.SetSeed(0)
+size = 1000
+X = ot.ComposedDistribution([ot.Uniform(0.0, 1.0)] * dim).getSample(size)
+Y = model(X)
+givenData = otmorris.MorrisGivenData(X, Y, ot.Interval(dim), 20, 0.9)
+x = np.array(X)
+y = np.array(Y)
+for i in range(dim):
+    pairs = np.array(givenData.getPairs(i)).reshape(-1, 2)
+    assert len(pairs) == givenData.getPairNumber()[i] and len(pairs) > 0
+    delta = x[pairs[:, 1]] - x[pairs[:, 0]]
+    # each pair is mainly along its input
+    assert np.all(np.abs(delta[:, i]) >= 0.9 * np.linalg.norm(delta, axis=1) - 1e-12)
+    effects = (y[pairs[:, 1]] - y[pairs[:, 0]]) / delta[:, i][:, None]
+    for j in range(2):
+        assert abs(givenData.getMeanElementaryEffects(j)[i] - effects[:, j].mean()) < 1e-10
+        assert abs(givenData.getMeanAbsoluteElementaryEffects(j)[i] - np.abs(effects[:, j]).mean()) < 1e-10
+    # unordered pairs are not repeated
+    assert len(set(tuple(sorted(p)) for p in pairs)) == len(pairs)
+print(givenData.getMeanElementaryEffects(0))
+
+# parallel queries do not change the result
+assert list(givenData.getPairs(0)) == list(otmorris.MorrisGivenData(X, Y, ot.Interval(dim), 20, 0.9).getPairs(0))
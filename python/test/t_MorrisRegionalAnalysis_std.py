@@ -0,0 +1,77 @@
+#!/usr/bin/env python
+
+from __future__ import print_function
+import openturns as ot
+import otmorris
+import numpy as np
+
+ot.RandomGenerator.SetSeed(0)
+dim = 3
+experiment = otmorris.MorrisExperimentGrid([5] * dim, 60)
+model = ot.SymbolicFunction(['x0', 'x1', 'x2'], ['x0 * x1 + x2', 'sin(3 * x0) + x2^2'])
+morris = otmorris.Morris(experiment, model)
+outputDimension = 2
+N = 60
+
+# effects of each trajectory, to check the regional statistics against
+effects = [np.array(morris.getElementaryEffects(marginal)) for marginal in range(outputDimension)]
+basePoints = np.array(morris.getInputSample())[::dim + 1]
+
+
+def check(regional):
+    indices = np.array(regional.getRegionIndices())
+    assert len(indices) == N
+    assert sum(regional.getTrajectoryNumber(r) for r in range(regional.getRegionNumber())) == N
+    for r in range(regional.getRegionNumber()):
+        members = indices == r
+        assert regional.getTrajectoryNumber(r) == np.count_nonzero(members)
+        for marginal in range(outputDimension):
+            ee = effects[marginal][members]
+            if len(ee) == 0:
+                continue
+            assert np.allclose(regional.getMeanElementaryEffects(r, marginal), ee.mean(axis=0))
+            assert np.allclose(regional.getMeanAbsoluteElementaryEffects(r, marginal), np.abs(ee).mean(axis=0))
+            sigma = ee.std(axis=0, ddof=1) if len(ee) > 1 else np.zeros(dim)
+            assert np.allclose(regional.getStandardDeviationElementaryEffects(r, marginal), sigma)
+        # base points lie in their region
+        bounds = regional.getRegion(r)
+        lower = np.array(bounds.getLowerBound())
+        upper = np.array(bounds.getUpperBound())
+        assert np.all(basePoints[members] >= lower) and np.all(basePoints[members] <= upper)
+
+
+# a single region gives the global statistics
+whole = otmorris.MorrisRegionalAnalysis(morris, [1] * dim)
+check(whole)
+assert whole.getRegionNumber() == 1
+for marginal in range(outputDimension):
+    assert np.allclose(whole.getMeanAbsoluteElementaryEffects(0, marginal), morris.getMeanAbsoluteElementaryEffects(marginal))
+    assert np.allclose(whole.getStandardDeviationElementaryEffects(0, marginal), morris.getStandardDeviationElementaryEffects(marginal))
+
+# grid cells
+grid = otmorris.MorrisRegionalAnalysis(morris, [2, 3, 1])
+check(grid)
+assert grid.getRegionNumber() == 6
+print(grid)
+
+# k-d cells hold at most leafSize distinct base points
+for leafSize in [4, 10]:
+    kd = otmorris.MorrisRegionalAnalysis(morris, leafSize)
+    check(kd)
+    indices = np.array(kd.getRegionIndices())
+    for r in range(kd.getRegionNumber()):
+        members = basePoints[indices == r]
+        assert len(members) <= leafSize or len(np.unique(members, axis=0)) == 1
+
+# user regions: the sign of x0 - 0.5, x0 only matters through the first output beyond it
+regionFunction = ot.SymbolicFunction(['x0', 'x1', 'x2'], ['x0 >= 0.5'])
+user = otmorris.MorrisRegionalAnalysis(morris, regionFunction)
+check(user)
+assert user.getRegionNumber() == 2
+print(user.getMeanElementaryEffects(0, 1), user.getMeanElementaryEffects(1, 1))
+
+try:
+    otmorris.MorrisRegionalAnalysis(morris, [2, 2])
+    raise AssertionError('bin numbers of the wrong size should be rejected')
+except (TypeError, ValueError):
+    pass
@@ -0,0 +1,85 @@
+#!/usr/bin/env python
+
+from __future__ import print_function
+import openturns as ot
+import openturns.testing as ott
+import otmorris
+import threading
+
+dim = 3
+bounds = ot.Interval([0.0] * dim, [1.0] * dim)
+experiment = otmorris.MorrisExperimentGrid([6] * dim, bounds, 50)
+model = ot.SymbolicFunction(['x0', 'x1', 'x2'], ['x0 * x1 + x2^2', 'x0 - x2'])
+
+# complete run, same analysis as the synchronous one
+ot.RandomGenerator.SetSeed(0)
+run = otmorris.MorrisRun(experiment, model, 7)
+result = run.getResult()
+ot.RandomGenerator.SetSeed(0)
+reference = otmorris.Morris(experiment, model)
+assert run.isDone() and not run.isCancelled()
+assert run.getEvaluationNumber() == run.getTotalEvaluationNumber() == 50 * (dim + 1)
+assert run.getEstimatedRemainingTime() == 0.0
+assert result.getInputSample() == reference.getInputSample()
+for marginal in range(2):
+    ott.assert_almost_equal(result.getMeanAbsoluteElementaryEffects(marginal), reference.getMeanAbsoluteElementaryEffects(marginal))
+    ott.assert_almost_equal(result.getStandardDeviationElementaryEffects(marginal), reference.getStandardDeviationElementaryEffects(marginal))
+
+# winding stairs: the points shared by consecutive blocks are evaluated once
+stairs = otmorris.MorrisExperimentWindingStairs([6] * dim, bounds, 50)
+ot.RandomGenerator.SetSeed(0)
+run = otmorris.MorrisRun(stairs, model, 7)
+# the design is drawn by the calling thread
+ot.RandomGenerator.SetSeed(0)
+reference = otmorris.Morris(stairs, model)
+result = run.getResult()
+assert run.getEvaluationNumber() == run.getTotalEvaluationNumber() == 50 * dim + 1
+assert result.getTrajectoryNumber() == 50
+for marginal in range(2):
+    ott.assert_almost_equal(result.getMeanAbsoluteElementaryEffects(marginal), reference.getMeanAbsoluteElementaryEffects(marginal))
+    ott.assert_almost_equal(result.getStandardDeviationElementaryEffects(marginal), reference.getStandardDeviationElementaryEffects(marginal))
+    ott.assert_almost_equal(result.getElementaryEffects(marginal), reference.getElementaryEffects(marginal))
+ott.assert_almost_equal(result.getOutputStandardDeviation(), reference.getOutputStandardDeviation())
+
+# cancelled run with a slow Python model gives a valid partial result
+gate = threading.Event()
+
+
+def slow_model(x):
+    gate.wait()
+    return [x[0] * x[1] + x[2] ** 2, x[0] - x[2]]
+
+
+run = otmorris.MorrisRun(experiment, ot.PythonFunction(dim, 2, slow_model), 1)
+run.cancel()
+gate.set()
+partial = run.getResult()
+assert run.isCancelled()
+assert partial.getTrajectoryNumber() < 50
+assert partial.getTrajectoryNumber() * (dim + 1) == run.getEvaluationNumber()
+assert partial.getInputSample().getSize() == run.getEvaluationNumber()
+snapshot = run.getSnapshot()
+assert snapshot.getTrajectoryNumber() == partial.getTrajectoryNumber()
+
+# cancelling a completed run has no effect
+run = otmorris.MorrisRun(experiment, model)
+run.wait()
+run.cancel()
+assert not run.isCancelled()
+assert run.getResult().getTrajectoryNumber() == 50
+
+# future interface
+future = otmorris.MorrisRun(experiment, model).future()
+assert future.result().getTrajectoryNumber() == 50
+
+# errors of the model are raised by getResult
+def failing_model(x):
+    raise ValueError('failure')
+
+
+run = otmorris.MorrisRun(experiment, ot.PythonFunction(dim, 2, failing_model))
+try:
+    run.getResult()
+    raise AssertionError('expected an error')
+except Exception:
+    pass
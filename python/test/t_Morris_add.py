@@ -0,0 +1,68 @@
+#!/usr/bin/env python
+
+from __future__ import print_function
+import openturns as ot
+import openturns.testing as ott
+import otmorris
+
+ot.RandomGenerator.SetSeed(0)
+dim = 4
+bounds = ot.Interval([0.0] * dim, [1.0, 2.0, 1.0, 3.0])
+model = ot.SymbolicFunction(['x0', 'x1', 'x2', 'x3'],
+                            ['x0 * x1 + sin(x2) + x3^2', 'x0 - x1 * x3'])
+experiment = otmorris.MorrisExperimentGrid([6] * dim, bounds, 20)
+morris = otmorris.Morris(experiment, model)
+
+# add a second batch of trajectories incrementally
+distribution = ot.ComposedDistribution(
+    [ot.Uniform(bounds.getLowerBound()[i], bounds.getUpperBound()[i]) for i in range(dim)])
+lhsDesign = ot.LHSExperiment(distribution, 30).generate()
+X2 = otmorris.MorrisExperimentLHS(lhsDesign, bounds, 12).generate()
+morris.add(X2, model(X2))
+morris.extend(experiment, model, 7)
+assert morris.getTrajectoryNumber() == 39
+
+# full recomputation from the concatenated samples
+reference = otmorris.Morris(morris.getInputSample(), morris.getOutputSample(), bounds)
+for marginal in range(2):
+    ott.assert_almost_equal(morris.getMeanElementaryEffects(marginal),
+                            reference.getMeanElementaryEffects(marginal))
+    ott.assert_almost_equal(morris.getMeanAbsoluteElementaryEffects(marginal),
+                            reference.getMeanAbsoluteElementaryEffects(marginal))
+    ott.assert_almost_equal(morris.getStandardDeviationElementaryEffects(marginal),
+                            reference.getStandardDeviationElementaryEffects(marginal))
+    # same ranking of the factors
+    muStar = morris.getMeanAbsoluteElementaryEffects(marginal)
+    referenceMuStar = reference.getMeanAbsoluteElementaryEffects(marginal)
+    assert sorted(range(dim), key=lambda i: muStar[i]) == sorted(range(dim), key=lambda i: referenceMuStar[i])
+
+# winding stairs chains are kept as independent trajectories of dim + 1 points
+stairs = otmorris.MorrisExperimentWindingStairs([6] * dim, bounds, 5)
+chained = otmorris.Morris(stairs, model)
+chained.extend(stairs, model, 3)
+chained.add(X2, model(X2))
+assert chained.getTrajectoryNumber() == 5 + 3 + 12
+assert chained.getInputSample().getSize() == chained.getTrajectoryNumber() * (dim + 1)
+reference = otmorris.Morris(chained.getInputSample(), chained.getOutputSample(), bounds)
+for marginal in range(2):
+    ott.assert_almost_equal(chained.getMeanElementaryEffects(marginal),
+                            reference.getMeanElementaryEffects(marginal))
+    ott.assert_almost_equal(chained.getStandardDeviationElementaryEffects(marginal),
+                            reference.getStandardDeviationElementaryEffects(marginal))
+    assert chained.getElementaryEffects(marginal).getSize() == chained.getTrajectoryNumber()
+
+# without trajectories, the sample-based queries fail instead of using partial samples
+ingestion = otmorris.Morris(bounds, 2)
+for k in range(3):
+    for i in range(dim + 1):
+        ingestion.addResult(k, i, X2[k * (dim + 1) + i], model(X2[k * (dim + 1) + i]))
+ingestion.add(X2, model(X2))
+assert ingestion.getTrajectoryNumber() == 3 + 12
+assert ingestion.getInputSample().getSize() == 0
+for query in [lambda: ingestion.getElementaryEffects(0),
+              lambda: ingestion.computeStandardRegressionCoefficients()]:
+    try:
+        query()
+        raise AssertionError('sample-based query should fail without trajectories')
+    except (TypeError, ValueError):
+        pass
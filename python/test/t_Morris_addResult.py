@@ -0,0 +1,105 @@
+#!/usr/bin/env python
+
+from __future__ import print_function
+import openturns as ot
+import openturns.testing as ott
+import otmorris
+import os
+import pickle
+import tempfile
+
+ot.RandomGenerator.SetSeed(0)
+dim = 3
+N = 15
+seed = 5
+bounds = ot.Interval([0.0, -1.0, 1.0], [1.0, 1.0, 3.0])
+experiment = otmorris.MorrisExperimentGrid([5] * dim, bounds, N)
+model = ot.SymbolicFunction(['x0', 'x1', 'x2'], ['x0 * x1 + exp(x2 / 3)', 'x1^2 - x0'])
+X = experiment.generate(0, 1, seed)
+Y = model(X)
+reference = otmorris.Morris(X, Y, bounds)
+
+# results come back in random order
+records = [(k, i) for k in range(N) for i in range(dim + 1)]
+order = ot.KPermutationsDistribution(len(records), len(records)).getRealization()
+reproducible = otmorris.Morris(experiment, seed, 2)
+explicit = otmorris.Morris(bounds, 2)
+completed = 0
+for index in order:
+    k, i = records[int(index)]
+    row = k * (dim + 1) + i
+    done = reproducible.addResult(k, i, Y[row])
+    assert done == explicit.addResult(k, i, X[row], Y[row])
+    completed += int(done)
+    assert reproducible.getTrajectoryNumber() == completed
+    assert reproducible.getPendingTrajectoryNumber() <= N - completed
+# a late replicate is discarded
+assert not reproducible.addResult(0, 0, Y[0])
+assert reproducible.getPendingTrajectoryNumber() == 0
+assert reproducible.getTrajectoryNumber() == N
+
+for morris in [reproducible, explicit]:
+    for marginal in range(2):
+        ott.assert_almost_equal(morris.getMeanElementaryEffects(marginal),
+                                reference.getMeanElementaryEffects(marginal))
+        ott.assert_almost_equal(morris.getMeanAbsoluteElementaryEffects(marginal),
+                                reference.getMeanAbsoluteElementaryEffects(marginal))
+        ott.assert_almost_equal(morris.getStandardDeviationElementaryEffects(marginal),
+                                reference.getStandardDeviationElementaryEffects(marginal))
+
+# the pending results survive pickling and XML storage
+half = len(order) // 2
+reproducible = otmorris.Morris(experiment, seed, 2)
+explicit = otmorris.Morris(bounds, 2)
+for index in order[:half]:
+    k, i = records[int(index)]
+    row = k * (dim + 1) + i
+    reproducible.addResult(k, i, Y[row])
+    explicit.addResult(k, i, X[row], Y[row])
+# pairs of a restored copy and whether its inputs are regenerated
+copies = [(pickle.loads(pickle.dumps(reproducible)), True),
+          (pickle.loads(pickle.dumps(explicit)), False)]
+if ot.PlatformInfo.HasFeature('libxml2'):
+    fileName = os.path.join(tempfile.mkdtemp(), 'morris.xml')
+    study = ot.Study()
+    study.setStorageManager(ot.XMLStorageManager(fileName))
+    study.add('reproducible', reproducible)
+    study.add('explicit', explicit)
+    study.save()
+    study = ot.Study()
+    study.setStorageManager(ot.XMLStorageManager(fileName))
+    study.load()
+    for name in ['reproducible', 'explicit']:
+        copy = otmorris.Morris()
+        study.fillObject(name, copy)
+        copies.append((copy, name == 'reproducible'))
+    os.remove(fileName)
+for copy, regenerated in copies:
+    assert copy.getPendingTrajectoryNumber() == reproducible.getPendingTrajectoryNumber()
+    assert copy.getTrajectoryNumber() == reproducible.getTrajectoryNumber()
+for index in order[half:]:
+    k, i = records[int(index)]
+    row = k * (dim + 1) + i
+    for copy, regenerated in copies:
+        if regenerated:
+            copy.addResult(k, i, Y[row])
+        else:
+            copy.addResult(k, i, X[row], Y[row])
+for copy, regenerated in copies:
+    assert copy.getPendingTrajectoryNumber() == 0
+    assert copy.getTrajectoryNumber() == N
+    for marginal in range(2):
+        ott.assert_almost_equal(copy.getMeanElementaryEffects(marginal),
+                                reference.getMeanElementaryEffects(marginal))
+        ott.assert_almost_equal(copy.getStandardDeviationElementaryEffects(marginal),
+                                reference.getStandardDeviationElementaryEffects(marginal))
+
+# winding stairs: one pending slot per trajectory of the experiment
+stairs = otmorris.MorrisExperimentWindingStairs([5] * dim, bounds, 4)
+ingestion = otmorris.Morris(stairs, seed, 2)
+assert not ingestion.addResult(3, 0, [0.0, 0.0])
+try:
+    ingestion.addResult(4, 0, [0.0, 0.0])
+    raise AssertionError('trajectory index should be checked against the experiment')
+except (TypeError, ValueError):
+    pass
@@ -0,0 +1,85 @@
+#!/usr/bin/env python
+
+from __future__ import print_function
+import openturns as ot
+import openturns.testing as ott
+import otmorris
+import os
+import tempfile
+import time
+
+ot.RandomGenerator.SetSeed(0)
+dim = 20
+N = 500
+bounds = ot.Interval([0.0] * dim, [1.0] * dim)
+experiment = otmorris.MorrisExperimentGrid([8] * dim, N)
+formula = ' + '.join(['%d * x%d * x%d' % (i + 1, i, (i + 1) % dim) for i in range(dim)])
+model = ot.SymbolicFunction(['x%d' % i for i in range(dim)], [formula, 'x0 - x1'])
+morris = otmorris.Morris(experiment, model)
+
+directory = tempfile.mkdtemp()
+binaryFileName = os.path.join(directory, 'morris.bin')
+statisticsFileName = os.path.join(directory, 'morris_stats.bin')
+xmlFileName = os.path.join(directory, 'morris.xml')
+
+t0 = time.time()
+morris.saveBinary(binaryFileName)
+t1 = time.time()
+loaded = otmorris.Morris.LoadBinary(binaryFileName)
+inputSample = loaded.getInputSample()
+t2 = time.time()
+print('binary: save %.3fs, load %.3fs, size %d bytes' % (t1 - t0, t2 - t1, os.path.getsize(binaryFileName)))
+
+# round trip
+assert loaded.getTrajectoryNumber() == N
+assert inputSample == morris.getInputSample()
+assert loaded.getOutputSample() == morris.getOutputSample()
+for marginal in range(2):
+    ott.assert_almost_equal(loaded.getMeanElementaryEffects(marginal), morris.getMeanElementaryEffects(marginal), 0.0, 0.0)
+    ott.assert_almost_equal(loaded.getMeanAbsoluteElementaryEffects(marginal), morris.getMeanAbsoluteElementaryEffects(marginal), 0.0, 0.0)
+    ott.assert_almost_equal(loaded.getStandardDeviationElementaryEffects(marginal), morris.getStandardDeviationElementaryEffects(marginal), 0.0, 0.0)
+
+# the descriptions of the samples are kept
+X = otmorris.MorrisExperimentGrid([8] * dim, 5).generate()
+X.setDescription(['a%d' % i for i in range(dim)])
+Y = model(X)
+Y.setDescription(['f', 'g'])
+otmorris.Morris(X, Y, bounds).saveBinary(binaryFileName)
+described = otmorris.Morris.LoadBinary(binaryFileName)
+assert described.getInputSample().getDescription() == X.getDescription()
+assert described.getOutputSample().getDescription() == Y.getDescription()
+
+# statistics only, the analysis can still be extended
+morris.saveBinary(statisticsFileName, False)
+statistics = otmorris.Morris.LoadBinary(statisticsFileName)
+assert statistics.getInputSample().getSize() == 0
+statistics.extend(experiment, model, 10)
+assert statistics.getTrajectoryNumber() == N + 10
+assert statistics.getInputSample().getSize() == 0
+try:
+    statistics.getElementaryEffects(0)
+    raise AssertionError('effects should not be available without the samples')
+except (TypeError, ValueError):
+    pass
+
+# XML storage for comparison
+if ot.PlatformInfo.HasFeature('libxml2'):
+    t0 = time.time()
+    study = ot.Study()
+    study.setStorageManager(ot.XMLStorageManager(xmlFileName))
+    study.add('morris', morris)
+    study.save()
+    t1 = time.time()
+    study = ot.Study()
+    study.setStorageManager(ot.XMLStorageManager(xmlFileName))
+    study.load()
+    xmlLoaded = otmorris.Morris()
+    study.fillObject('morris', xmlLoaded)
+    t2 = time.time()
+    print('xml: save %.3fs, load %.3fs, size %d bytes' % (t1 - t0, t2 - t1, os.path.getsize(xmlFileName)))
+    assert os.path.getsize(binaryFileName) < os.path.getsize(xmlFileName)
+    os.remove(xmlFileName)
+
+os.remove(binaryFileName)
+os.remove(statisticsFileName)
+os.rmdir(directory)
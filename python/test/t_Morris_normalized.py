@@ -0,0 +1,53 @@
+#!/usr/bin/env python
+
+from __future__ import print_function
+import openturns as ot
+import openturns.testing as ott
+import otmorris
+import numpy as np
+import pickle
+import os
+import tempfile
+
+ot.RandomGenerator.SetSeed(0)
+dim = 3
+bounds = ot.Interval([0.0, -10.0, 100.0], [1.0, 10.0, 200.0])
+experiment = otmorris.MorrisExperimentGrid([5] * dim, bounds, 20)
+model = ot.SymbolicFunction(['x0', 'x1', 'x2'], ['x0 + 0.1 * x1 + 0.01 * x2', '1000 * x0^2'])
+morris = otmorris.Morris(experiment, model)
+
+# output moments match the samples
+Y = np.array(morris.getOutputSample())
+sigmaY = Y.std(axis=0, ddof=1)
+ott.assert_almost_equal(morris.getOutputStandardDeviation(), sigmaY, 1e-10, 1e-10)
+
+muStar = np.array(morris.getMeanAbsoluteElementaryEffects())
+width = np.array(bounds.getUpperBound()) - np.array(bounds.getLowerBound())
+ott.assert_almost_equal(morris.getScaledMeanAbsoluteElementaryEffects(), muStar / sigmaY[0], 1e-10, 1e-10)
+ott.assert_almost_equal(morris.getNormalizedMeanAbsoluteElementaryEffects(), muStar / sigmaY[0] / np.sqrt(12.0), 1e-10, 1e-10)
+distribution = ot.ComposedDistribution([ot.Normal(0.5, 0.2), ot.Normal(0.0, 3.0), ot.Uniform(100.0, 200.0)])
+sigmaX = np.array([0.2, 3.0, 100.0 / np.sqrt(12.0)])
+ott.assert_almost_equal(morris.getNormalizedMeanAbsoluteElementaryEffects(distribution), muStar * sigmaX / width / sigmaY[0], 1e-10, 1e-10)
+# uniform distributions over the interval give the interval normalization
+uniform = ot.ComposedDistribution([ot.Uniform(bounds.getLowerBound()[i], bounds.getUpperBound()[i]) for i in range(dim)])
+ott.assert_almost_equal(morris.getNormalizedMeanAbsoluteElementaryEffects(uniform, 1), morris.getNormalizedMeanAbsoluteElementaryEffects(1), 1e-10, 1e-10)
+
+# the moments are updated when trajectories are added
+more = experiment.generate()
+morris.add(more, model(more))
+Y = np.vstack([Y, np.array(model(more))])
+ott.assert_almost_equal(morris.getOutputStandardDeviation(), Y.std(axis=0, ddof=1), 1e-10, 1e-10)
+
+# winding stairs count the shared points once
+stairs = otmorris.MorrisExperimentWindingStairs([5] * dim, bounds, 10)
+chained = otmorris.Morris(stairs, model)
+ott.assert_almost_equal(chained.getOutputStandardDeviation(), np.array(chained.getOutputSample()).std(axis=0, ddof=1), 1e-10, 1e-10)
+
+# the moments are kept by the binary storage and pickling
+fileName = os.path.join(tempfile.gettempdir(), 'morris_normalized.bin')
+morris.saveBinary(fileName, False)
+loaded = otmorris.Morris.LoadBinary(fileName)
+ott.assert_almost_equal(loaded.getOutputStandardDeviation(), morris.getOutputStandardDeviation(), 1e-14, 1e-14)
+os.remove(fileName)
+copy = pickle.loads(pickle.dumps(morris))
+ott.assert_almost_equal(copy.getNormalizedMeanAbsoluteElementaryEffects(), morris.getNormalizedMeanAbsoluteElementaryEffects(), 1e-14, 1e-14)
@@ -0,0 +1,41 @@
+#!/usr/bin/env python
+
+from __future__ import print_function
+import openturns as ot
+import otmorris
+import numpy as np
+
+ot.RandomGenerator.SetSeed(0)
+dim = 4
+bounds = ot.Interval([0.0] * dim, [2.0] * dim)
+experiment = otmorris.MorrisExperimentGrid([5] * dim, bounds, 30)
+# x0 dominates, x1 is active, x2 has a tiny effect and x3 none
+model = ot.SymbolicFunction(['x0', 'x1', 'x2', 'x3'], ['10 * x0 + x1^2 + 1e-6 * x2', 'x1 * x0'])
+morris = otmorris.Morris(experiment, model)
+
+for method in ['output', 'sign']:
+    pValues = morris.computePermutationPValues(199, method, 7)
+    print(method, pValues)
+    assert pValues.getSize() == 2 and pValues.getDimension() == dim
+    p = np.array(pValues)
+    assert np.all(p > 0.0) and np.all(p <= 1.0)
+    # the smallest p-value is 1 / (B + 1)
+    assert abs(p[0, 0] - 1.0 / 200.0) < 1e-12
+    assert p[0, 3] == 1.0 and p[1, 3] == 1.0 and p[1, 2] == 1.0
+    # reproducible from the seed
+    assert morris.computePermutationPValues(199, method, 7) == pValues
+
+# the sign test with the exact distribution of a symmetric null: effects of x3 are zero
+# so every flip gives the same statistic
+assert morris.computePermutationPValues(99, 'sign', 1)[0, 3] == 1.0
+
+# different seeds give different draws of the null distribution
+other = morris.computePermutationPValues(199, 'output', 8)
+assert other[0, 0] == 1.0 / 200.0
+
+# unknown methods are rejected
+try:
+    morris.computePermutationPValues(10, 'bootstrap')
+    raise AssertionError('unknown methods should be rejected')
+except (TypeError, ValueError):
+    pass
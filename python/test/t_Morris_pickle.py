@@ -0,0 +1,51 @@
+#!/usr/bin/env python
+
+from __future__ import print_function
+import openturns as ot
+import openturns.testing as ott
+import otmorris
+import pickle
+
+ot.RandomGenerator.SetSeed(0)
+dim = 3
+bounds = ot.Interval([0.0, -1.0, 2.0], [1.0, 1.0, 5.0])
+grid = otmorris.MorrisExperimentGrid([5] * dim, bounds, 10)
+grid.setJumpStep([2, 1, 2])
+lhsDesign = ot.LHSExperiment(ot.ComposedDistribution([ot.Uniform(0.0, 1.0)] * dim), 20).generate()
+lhs = otmorris.MorrisExperimentLHS(lhsDesign, 8)
+model = ot.SymbolicFunction(['x0', 'x1', 'x2'], ['x0 * x1 + x2', 'x1^2'])
+morris = otmorris.Morris(grid, model)
+
+for experiment in [grid, lhs]:
+    copy = pickle.loads(pickle.dumps(experiment, pickle.HIGHEST_PROTOCOL))
+    assert copy.getClassName() == experiment.getClassName()
+    assert copy.getBounds() == experiment.getBounds()
+    assert copy.getTrajectoryNumber() == experiment.getTrajectoryNumber()
+    assert copy.getSize() == experiment.getSize()
+    # only the parameters are transferred, the designs are the same
+    assert copy.generate(0, 1, 3) == experiment.generate(0, 1, 3)
+    ot.RandomGenerator.SetSeed(1)
+    sample = experiment.generate()
+    ot.RandomGenerator.SetSeed(1)
+    assert copy.generate() == sample
+assert pickle.loads(pickle.dumps(grid)).getJumpStep() == grid.getJumpStep()
+
+copy = pickle.loads(pickle.dumps(morris, pickle.HIGHEST_PROTOCOL))
+assert copy.getInputSample() == morris.getInputSample()
+assert copy.getOutputSample() == morris.getOutputSample()
+assert copy.getTrajectoryNumber() == morris.getTrajectoryNumber()
+for marginal in range(2):
+    ott.assert_almost_equal(copy.getMeanElementaryEffects(marginal), morris.getMeanElementaryEffects(marginal), 0.0, 0.0)
+    ott.assert_almost_equal(copy.getMeanAbsoluteElementaryEffects(marginal), morris.getMeanAbsoluteElementaryEffects(marginal), 0.0, 0.0)
+    ott.assert_almost_equal(copy.getStandardDeviationElementaryEffects(marginal), morris.getStandardDeviationElementaryEffects(marginal), 0.0, 0.0)
+# the descriptions of the samples are kept
+X = grid.generate()
+X.setDescription(['a', 'b', 'c'])
+Y = model(X)
+Y.setDescription(['f', 'g'])
+described = pickle.loads(pickle.dumps(otmorris.Morris(X, Y, bounds)))
+assert described.getInputSample().getDescription() == X.getDescription()
+assert described.getOutputSample().getDescription() == Y.getDescription()
+# the copy can be extended
+copy.extend(grid, model, 2)
+assert copy.getTrajectoryNumber() == morris.getTrajectoryNumber() + 2
@@ -0,0 +1,50 @@
+#!/usr/bin/env python
+
+from __future__ import print_function
+import openturns as ot
+import otmorris
+import numpy as np
+
+ot.RandomGenerator.SetSeed(0)
+dim = 4
+experiment = otmorris.MorrisExperimentGrid([5] * dim, 25)
+model = ot.SymbolicFunction(['x0', 'x1', 'x2', 'x3'], ['2 * x0 - x1 + 0.1 * x2', 'x0 * x3 + exp(3 * x1)', '1.0'])
+morris = otmorris.Morris(experiment, model)
+X = np.array(morris.getInputSample())
+Y = np.array(morris.getOutputSample())
+
+
+def ranks(values):
+    # mean ranks of the ties
+    order = np.argsort(values, kind='stable')
+    result = np.empty(len(values))
+    sortedValues = values[order]
+    first = 0
+    while first < len(values):
+        last = first + 1
+        while last < len(values) and sortedValues[last] == sortedValues[first]:
+            last += 1
+        result[order[first:last]] = 0.5 * (first + last - 1)
+        first = last
+    return result
+
+
+for rank in [False, True]:
+    src = np.array(morris.computeStandardRegressionCoefficients(rank))
+    r2 = np.array(morris.computeRegressionDetermination(rank))
+    assert src.shape == (3, dim)
+    inputs = np.column_stack([ranks(c) for c in X.T]) if rank else X
+    Zx = (inputs - inputs.mean(axis=0)) / inputs.std(axis=0)
+    for j in range(2):
+        outputs = ranks(Y[:, j]) if rank else Y[:, j]
+        zy = (outputs - outputs.mean()) / outputs.std()
+        beta = np.linalg.lstsq(Zx, zy, rcond=None)[0]
+        assert np.allclose(src[j], beta), (rank, j)
+        residual = zy - Zx.dot(beta)
+        assert np.allclose(r2[j], 1.0 - residual.dot(residual) / zy.dot(zy))
+    # constant output
+    assert np.all(src[2] == 0.0) and r2[2] == 0.0
+    print(src, r2)
+
+# the linear output is fully explained
+assert abs(morris.computeRegressionDetermination()[0] - 1.0) < 1e-10
@@ -0,0 +1,39 @@
+#!/usr/bin/env python
+
+from __future__ import print_function
+import openturns as ot
+import otmorris
+
+# enough trajectories and points for many reduction blocks
+ot.RandomGenerator.SetSeed(0)
+dim = 6
+experiment = otmorris.MorrisExperimentGrid([8] * dim, 1500)
+X = experiment.generate()
+model = ot.SymbolicFunction(['x' + str(i) for i in range(dim)],
+                            ['1e6 + exp(x0) * x1 - 3 * x2 * x3^2 + sin(10 * x4) * x5', 'x0 * x1 * x2 * x3'])
+Y = model(X)
+bounds = experiment.getBounds()
+
+
+def statistics():
+    morris = otmorris.Morris(X, Y, bounds)
+    values = []
+    for marginal in range(2):
+        values += list(morris.getMeanElementaryEffects(marginal))
+        values += list(morris.getMeanAbsoluteElementaryEffects(marginal))
+        values += list(morris.getStandardDeviationElementaryEffects(marginal))
+    values += list(morris.getOutputStandardDeviation())
+    return [value.hex() for value in values]
+
+
+# bitwise identical whatever the number of threads
+threadNumber = ot.TBB.GetNumberOfThreads()
+reference = None
+for n in [1, 2, 3, 8, 128]:
+    ot.TBB.SetNumberOfThreads(n)
+    current = statistics()
+    if reference is None:
+        reference = current
+    assert current == reference, n
+ot.TBB.SetNumberOfThreads(threadNumber)
+print(reference[:dim])
@@ -0,0 +1,76 @@
+#!/usr/bin/env python
+
+from __future__ import print_function
+import os
+import tempfile
+import numpy as np
+import openturns as ot
+import openturns.testing as ott
+import otmorris
+
+ot.RandomGenerator.SetSeed(0)
+dim = 5
+bounds = ot.Interval([-1.0] * dim, [2.0] * dim)
+experiment = otmorris.MorrisExperimentGrid([5] * dim, bounds, 200)
+X = experiment.generate()
+model = ot.SymbolicFunction(['x0', 'x1', 'x2', 'x3', 'x4'],
+                            ['x0 + 2 * x1 * x2 + sin(x3)', '1e3 + x0 * x3 - x4^2'])
+Y = model(X)
+reference = otmorris.Morris(X, Y, bounds)
+assert not reference.getSinglePrecision()
+
+
+def compare(name, morris, rtol, atol):
+    statistics = ['getMeanElementaryEffects', 'getMeanAbsoluteElementaryEffects', 'getStandardDeviationElementaryEffects']
+    for statistic in statistics:
+        errors = []
+        for marginal in range(2):
+            value = np.array(getattr(morris, statistic)(marginal))
+            expected = np.array(getattr(reference, statistic)(marginal))
+            ott.assert_almost_equal(value, expected, rtol, atol)
+            errors.append(np.max(np.abs(value - expected) / np.maximum(np.abs(expected), 1e-300)))
+        # measured relative error against the double path, per statistic and marginal
+        print(name, statistic, 'relative errors', ['%.1e' % error for error in errors])
+
+
+# float32 effects, accumulated in double
+morris = otmorris.Morris(bounds, 2)
+morris.setSinglePrecision(True)
+morris.add(X, Y)
+assert morris.getSinglePrecision()
+assert morris.getTrajectoryNumber() == reference.getTrajectoryNumber()
+compare('float32 effects', morris, 1e-6, 1e-6)
+ott.assert_almost_equal(morris.getOutputStandardDeviation(), reference.getOutputStandardDeviation(), 0.0, 0.0)
+
+# float32 designs written to file then mapped
+work_dir = tempfile.mkdtemp()
+for fmt in ['npy32', 'raw32']:
+    fileName = os.path.join(work_dir, 'X.' + fmt)
+    writer = otmorris.TrajectoryFile(fileName, dim, fmt)
+    for k in range(200):
+        writer.add(X[k * (dim + 1):(k + 1) * (dim + 1)])
+    writer.close()
+    ott.assert_almost_equal(otmorris.TrajectoryFile.Read(fileName, 0, 200), X, 1e-7, 0.0)
+np.save(os.path.join(work_dir, 'X.npy'), np.array(X, dtype=np.float32))
+np.save(os.path.join(work_dir, 'Y.npy'), np.array(Y, dtype=np.float32))
+mX = otmorris.MemoryMappedSample(os.path.join(work_dir, 'X.npy'))
+mY = otmorris.MemoryMappedSample(os.path.join(work_dir, 'Y.npy'))
+assert mX.isSinglePrecision() and mY.isSinglePrecision()
+ott.assert_almost_equal(mX.getSample(0, X.getSize()), X, 1e-7, 0.0)
+morris = otmorris.Morris(mX, mY, bounds)
+# float32 files do not change the storage of the effects
+assert not morris.getSinglePrecision()
+# the output 1e3 + ... loses about 6e-5 per value, which the differences of the effects amplify
+compare('float32 npy samples', morris, 1e-3, 1e-3)
+np.array(Y, dtype=np.float32).tofile(os.path.join(work_dir, 'Y.bin'))
+mY = otmorris.MemoryMappedSample(os.path.join(work_dir, 'Y.bin'), 2, True)
+assert mY.getSize() == Y.getSize()
+morris = otmorris.Morris(otmorris.MemoryMappedSample(os.path.join(work_dir, 'X.npy')), mY, bounds)
+compare('float32 raw samples', morris, 1e-3, 1e-3)
+
+# persistence of the mode
+morris.setSinglePrecision(True)
+morris.saveBinary(os.path.join(work_dir, 'morris.bin'))
+assert otmorris.Morris.LoadBinary(os.path.join(work_dir, 'morris.bin')).getSinglePrecision()
+del mX, mY, morris
+print(reference.getMeanAbsoluteElementaryEffects(0))
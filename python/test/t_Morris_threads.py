@@ -0,0 +1,91 @@
+#!/usr/bin/env python
+
+from __future__ import print_function
+import openturns as ot
+import openturns.testing as ott
+import otmorris
+import sys
+import threading
+import time
+
+dim = 5
+bounds = ot.Interval([0.0] * dim, [1.0] * dim)
+experiment = otmorris.MorrisExperimentGrid([6] * dim, bounds, 40)
+symbolic = ot.SymbolicFunction(['x%d' % i for i in range(dim)], ['x0 * x1 + x2^2 - x3 + 0.1 * x4'])
+
+
+def python_model(x):
+    return [x[0] * x[1] + x[2] ** 2 - x[3] + 0.1 * x[4]]
+
+
+models = [symbolic, ot.PythonFunction(dim, 1, python_model)]
+
+
+def screening(seed, model, results):
+    # reproducible designs do not use the shared random generator
+    X = experiment.generate(0, 1, seed)
+    morris = otmorris.Morris(X, model(X), bounds)
+    results[seed] = morris.getMeanAbsoluteElementaryEffects()
+
+
+results = {}
+threads = [threading.Thread(target=screening, args=(seed, models[seed % 2], results)) for seed in range(8)]
+for thread in threads:
+    thread.start()
+for thread in threads:
+    thread.join()
+
+# same results as sequential runs
+for seed in range(8):
+    expected = {}
+    screening(seed, symbolic, expected)
+    ott.assert_almost_equal(results[seed], expected[seed])
+
+# Python models are evaluated while the GIL is released by the calling thread
+ot.RandomGenerator.SetSeed(0)
+morris = {}
+
+
+def screen_python():
+    morris['python'] = otmorris.Morris(experiment, models[1])
+
+
+thread = threading.Thread(target=screen_python)
+thread.start()
+thread.join()
+X = morris['python'].getInputSample()
+expected = otmorris.Morris(X, symbolic(X), bounds)
+ott.assert_almost_equal(morris['python'].getMeanAbsoluteElementaryEffects(),
+                        expected.getMeanAbsoluteElementaryEffects())
+
+# another Python thread makes progress during long calls: with a huge switch
+# interval, the counter only runs when the calling thread releases the GIL,
+# so that its progress between two statements happens inside the call
+counter = [0]
+started = threading.Event()
+stop = threading.Event()
+
+
+def count():
+    started.set()
+    while not stop.is_set():
+        counter[0] += 1
+        # give the GIL back at once, not after the switch interval
+        time.sleep(0)
+
+
+interval = sys.getswitchinterval()
+sys.setswitchinterval(1000.0)
+counting = threading.Thread(target=count)
+counting.start()
+started.wait()
+# 2 * 9^5 trajectories are possible on this grid
+large = otmorris.MorrisExperimentGrid([10] * dim, bounds, 20000)
+for call in [lambda: large.generate(), lambda: otmorris.Morris(large, symbolic),
+             lambda: otmorris.Morris(experiment, models[1])]:
+    before = counter[0]
+    call()
+    assert counter[0] > before, 'the GIL should be released during the call'
+stop.set()
+counting.join()
+sys.setswitchinterval(interval)
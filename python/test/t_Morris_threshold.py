@@ -0,0 +1,48 @@
+#!/usr/bin/env python
+
+from __future__ import print_function
+import openturns as ot
+import otmorris
+import numpy as np
+
+ot.RandomGenerator.SetSeed(0)
+dim = 4
+experiment = otmorris.MorrisExperimentGrid([5] * dim, 30)
+bounds = experiment.getBounds()
+model = ot.SymbolicFunction(['x0', 'x1', 'x2', 'x3'], ['x0 + 0.2 * x1 * x2', 'x3'])
+morris = otmorris.Morris(experiment, model)
+X = morris.getInputSample()
+y = np.array(morris.getOutputSample())[:, 0]
+thresholds = [0.2, 0.5, 0.8]
+
+for bandwidth in [0.0, 0.1]:
+    analysis = morris.computeThresholdAnalysis(thresholds, 0, bandwidth)
+    indicators = np.array(analysis.getOutputSample())
+    assert indicators.shape == (len(y), len(thresholds))
+    if bandwidth == 0.0:
+        expected = (y[:, None] > np.array(thresholds)[None, :]).astype(float)
+    else:
+        expected = 1.0 / (1.0 + np.exp((np.array(thresholds)[None, :] - y[:, None]) / bandwidth))
+    assert np.allclose(indicators, expected)
+    # same statistics as a plain analysis of the indicators, and as each threshold alone
+    reference = otmorris.Morris(X, ot.Sample(expected), bounds)
+    for j, threshold in enumerate(thresholds):
+        single = morris.computeThresholdAnalysis([threshold], 0, bandwidth)
+        for statistic in ['getMeanAbsoluteElementaryEffects', 'getStandardDeviationElementaryEffects']:
+            value = np.array(getattr(analysis, statistic)(j))
+            assert np.allclose(value, getattr(reference, statistic)(j))
+            assert np.allclose(value, getattr(single, statistic)(0))
+    print(analysis.getOutputSample().getDescription())
+    print(analysis.getMeanAbsoluteElementaryEffects(1))
+
+# x3 does not move the first output across any threshold
+analysis = morris.computeThresholdAnalysis(thresholds)
+for j in range(len(thresholds)):
+    assert analysis.getMeanAbsoluteElementaryEffects(j)[3] == 0.0
+
+for args in [([], 0, 0.0), (thresholds, 2, 0.0), (thresholds, 0, -1.0)]:
+    try:
+        morris.computeThresholdAnalysis(*args)
+        raise AssertionError('invalid arguments should be rejected')
+    except (TypeError, ValueError):
+        pass
@@ -0,0 +1,41 @@
+#!/usr/bin/env python
+
+from __future__ import print_function
+import openturns as ot
+import otmorris
+import numpy as np
+
+ot.RandomGenerator.SetSeed(0)
+dim = 12
+experiment = otmorris.MorrisExperimentGrid([5] * dim, 10)
+inputs = ['x' + str(i) for i in range(dim)]
+formulas = [' + '.join(str(c) + ' * x' + str(i) for i, c in enumerate(coefficients)) for coefficients in
+            [np.arange(dim) % 5, -np.arange(dim)[::-1], np.ones(dim)]]
+formulas.append('x3^2 * x7 - 5 * x1')
+model = ot.SymbolicFunction(inputs, formulas)
+morris = otmorris.Morris(experiment, model)
+outputDimension = len(formulas)
+
+for statistic, getter in [('mu*', morris.getMeanAbsoluteElementaryEffects), ('mu', morris.getMeanElementaryEffects), ('sigma', morris.getStandardDeviationElementaryEffects)]:
+    for k in [1, 4, dim]:
+        indices = np.array(morris.getTopFactors(k, statistic)).reshape(outputDimension, k)
+        values = np.array(morris.getTopFactorValues(k, statistic))
+        assert values.shape == (outputDimension, k)
+        for marginal in range(outputDimension):
+            full = np.array(getter(marginal))
+            key = np.abs(full) if statistic == 'mu' else full
+            # stable sort on the opposite values breaks ties by the lowest index
+            expected = np.argsort(-key, kind='stable')[:k]
+            assert list(indices[marginal]) == list(expected), (statistic, k, marginal)
+            assert np.all(values[marginal] == full[expected])
+
+# ranks by absolute value for mu, whose sign is kept
+print(morris.getTopFactors(3, 'mu'))
+assert morris.getTopFactors(1, 'mu')[1] == 0 and morris.getTopFactorValues(1, 'mu')[1, 0] < 0.0
+
+for k, statistic in [(0, 'mu*'), (dim + 1, 'mu*'), (2, 'median')]:
+    try:
+        morris.getTopFactors(k, statistic)
+        raise AssertionError('invalid arguments should be rejected')
+    except (TypeError, ValueError):
+        pass
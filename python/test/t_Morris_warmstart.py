@@ -0,0 +1,95 @@
+#!/usr/bin/env python
+
+from __future__ import print_function
+import openturns as ot
+import openturns.testing as ott
+import otmorris
+import threading
+
+dim = 3
+N = 12
+bounds = ot.Interval([0.0] * dim, [1.0] * dim)
+experiment = otmorris.MorrisExperimentGrid([5] * dim, bounds, N)
+model = ot.SymbolicFunction(['x0', 'x1', 'x2'], ['x0 * x1 + x2^2', 'x1 - x2'])
+
+# each worker evaluates its trajectories as one sample
+batches = []
+lock = threading.Lock()
+
+
+def batch_solver(X):
+    with lock:
+        batches.append(ot.Sample(X))
+    return model(X)
+
+
+batchModel = ot.PythonFunction(dim, 2, func_sample=batch_solver)
+
+for workerNumber in [1, 3]:
+    for reorder in [False, True]:
+        ot.RandomGenerator.SetSeed(0)
+        reference = otmorris.Morris(experiment, model)
+        X = reference.getInputSample()
+        del batches[:]
+        ot.RandomGenerator.SetSeed(0)
+        morris = otmorris.Morris(experiment, batchModel, workerNumber, reorder)
+        assert morris.getInputSample() == X
+        ott.assert_almost_equal(morris.getOutputSample(), reference.getOutputSample())
+        ott.assert_almost_equal(morris.getMeanAbsoluteElementaryEffects(1), reference.getMeanAbsoluteElementaryEffects(1))
+        assert len(batches) == workerNumber
+        assert sum(batch.getSize() for batch in batches) == N * (dim + 1)
+        # whole trajectories, without reordering in design order
+        for batch in batches:
+            assert batch.getSize() % (dim + 1) == 0
+        if not reorder:
+            rows = [tuple(X[i]) for i in range(X.getSize())]
+            for batch in batches:
+                first = rows.index(tuple(batch[0]))
+                assert [tuple(batch[i]) for i in range(batch.getSize())] == rows[first:first + batch.getSize()]
+
+
+# warm start: each worker calls its own model point by point, in trajectory order
+class WarmStartSolver(ot.OpenTURNSPythonFunction):
+    def __init__(self):
+        super(WarmStartSolver, self).__init__(dim, 2)
+        self.points = []
+        self.active = False
+
+    def _exec(self, x):
+        # never called concurrently with itself
+        assert not self.active
+        self.active = True
+        if self.points:
+            # the solution of the previous point is the state of this model
+            ott.assert_almost_equal(self.solution, model(self.points[-1]))
+        self.points.append(list(x))
+        self.solution = model(x)
+        self.active = False
+        return self.solution
+
+
+for workerNumber in [1, 4]:
+    for reorder in [False, True]:
+        solvers = [WarmStartSolver() for worker in range(workerNumber)]
+        ot.RandomGenerator.SetSeed(0)
+        morris = otmorris.Morris(experiment, ot.FunctionCollection([ot.Function(solver) for solver in solvers]), reorder)
+        X = morris.getInputSample()
+        ott.assert_almost_equal(morris.getOutputSample(), model(X))
+        ott.assert_almost_equal(morris.getMeanElementaryEffects(), reference.getMeanElementaryEffects())
+        assert sum(len(solver.points) for solver in solvers) == N * (dim + 1)
+        for solver in solvers:
+            assert len(solver.points) % (dim + 1) == 0
+            # consecutive points of a trajectory differ along one input only
+            for k in range(len(solver.points) // (dim + 1)):
+                trajectory = solver.points[k * (dim + 1):(k + 1) * (dim + 1)]
+                for i in range(dim):
+                    assert sum(a != b for a, b in zip(trajectory[i], trajectory[i + 1])) == 1
+        if workerNumber == 1 and not reorder:
+            assert solvers[0].points == [list(X[i]) for i in range(X.getSize())]
+
+# models of different dimensions are rejected
+try:
+    otmorris.Morris(experiment, ot.FunctionCollection([model, ot.SymbolicFunction(['x0', 'x1', 'x2'], ['x0'])]))
+    raise AssertionError('models of different output dimensions should be rejected')
+except (TypeError, ValueError):
+    pass
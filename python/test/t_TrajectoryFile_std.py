@@ -0,0 +1,80 @@
+#!/usr/bin/env python
+
+from __future__ import print_function
+import os
+import tempfile
+import openturns as ot
+import openturns.testing as ott
+import otmorris
+
+ot.RandomGenerator.SetSeed(0)
+dim = 3
+r = 20
+work_dir = tempfile.mkdtemp()
+
+lhs = ot.LHSExperiment(ot.ComposedDistribution([ot.Uniform(0, 1)] * dim), 50, True, False).generate()
+experiments = [otmorris.MorrisExperimentGrid([5] * dim, r),
+               otmorris.MorrisExperimentLHS(lhs, r)]
+for experiment in experiments:
+    for fmt in ['npy', 'raw', 'csv']:
+        fileName = os.path.join(work_dir, 'design.' + fmt)
+        experiment.generateToFile(fileName, fmt)
+        X = otmorris.TrajectoryFile.Read(fileName, 0, r)
+        assert X.getSize() == r * (dim + 1), 'wrong size'
+        assert len(set(tuple(X[k * (dim + 1):(k + 1) * (dim + 1)].asPoint()) for k in range(r))) == r, 'replicates'
+        # any range is read through the index
+        ott.assert_almost_equal(otmorris.TrajectoryFile.Read(fileName, 5, 7),
+                                X[5 * (dim + 1):12 * (dim + 1)], 0.0, 0.0)
+        if fmt == 'npy':
+            mapped = otmorris.MemoryMappedSample(fileName)
+            ott.assert_almost_equal(mapped.getSample(0, mapped.getSize()), X, 0.0, 0.0)
+
+# the file holds the same trajectories as generate(), including on a coarse grid with many replicates
+coarse = otmorris.MorrisExperimentGrid([4] * 2, 10)
+fileName = os.path.join(work_dir, 'coarse.npy')
+ot.RandomGenerator.SetSeed(3)
+coarse.generateToFile(fileName)
+ot.RandomGenerator.SetSeed(3)
+design = coarse.generate()
+written = otmorris.TrajectoryFile.Read(fileName, 0, 10)
+assert sorted(tuple(written[k * 3:(k + 1) * 3].asPoint()) for k in range(10)) == \
+    sorted(tuple(design[k * 3:(k + 1) * 3].asPoint()) for k in range(10))
+
+# writer used directly
+writer = otmorris.TrajectoryFile(os.path.join(work_dir, 'custom.npy'), 2)
+writer.add([[0.0, 0.0], [1.0, 0.0], [1.0, 1.0]])
+writer.add([[0.5, 0.5], [0.5, 1.0], [1.0, 1.0]])
+writer.close()
+assert writer.getTrajectoryNumber() == 2
+ott.assert_almost_equal(otmorris.TrajectoryFile.Read(os.path.join(work_dir, 'custom.npy'), 1, 1),
+                        [[0.5, 0.5], [0.5, 1.0], [1.0, 1.0]], 0.0, 0.0)
+
+# a writer that is not closed is finalized when destroyed
+fileName = os.path.join(work_dir, 'unclosed.npy')
+writer = otmorris.TrajectoryFile(fileName, 2)
+writer.add([[0.0, 0.0], [1.0, 0.0], [1.0, 1.0]])
+writer.add([[0.5, 0.5], [0.5, 1.0], [1.0, 1.0]])
+del writer
+assert os.path.exists(fileName + '.index')
+ott.assert_almost_equal(otmorris.TrajectoryFile.Read(fileName, 1, 1),
+                        [[0.5, 0.5], [0.5, 1.0], [1.0, 1.0]], 0.0, 0.0)
+mapped = otmorris.MemoryMappedSample(fileName)
+assert mapped.getSize() == 6
+del mapped
+
+
+# also when an exception interrupts the writing
+def write_until_failure(fileName):
+    writer = otmorris.TrajectoryFile(fileName, 2)
+    writer.add([[0.0, 0.0], [1.0, 0.0], [1.0, 1.0]])
+    writer.add([[0.0, 0.0, 0.0]])
+
+
+fileName = os.path.join(work_dir, 'interrupted.npy')
+try:
+    write_until_failure(fileName)
+    raise AssertionError('a trajectory of the wrong dimension should be rejected')
+except Exception:
+    pass
+ott.assert_almost_equal(otmorris.TrajectoryFile.Read(fileName, 0, 1),
+                        [[0.0, 0.0], [1.0, 0.0], [1.0, 1.0]], 0.0, 0.0)